@@ -67,6 +67,8 @@ typedef struct _BitmapFont {
     CharInfoPtr **encoding;	/* array of arrays of char info pointers */
     CharInfoPtr pDefault;	/* default character */
     BitmapExtraPtr bitmapExtra;	/* stuff not used by X server */
+    void       *mapping;	/* file mapping bitmaps point into, if any */
+    size_t      mappingSize;
 }           BitmapFontRec, *BitmapFontPtr;
 
 #define ACCESSENCODING(enc,i) \
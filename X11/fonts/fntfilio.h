@@ -52,5 +52,7 @@ extern int FontFileClose ( FontFilePtr f );
 extern FontFilePtr FontFileOpenWrite ( const char *name );
 extern FontFilePtr FontFileOpenWriteFd ( int fd );
 extern FontFilePtr FontFileOpenFd ( int fd );
+extern void *FontFileMap ( FontFilePtr f, size_t *sizep );
+extern void FontFileUnmap ( void *addr, size_t size );
 
 #endif /* _FNTFILIO_H_ */
@@ -229,6 +229,10 @@ FcConfigCreate (void)
     if (!config->availConfigFiles)
 	goto bail10;
 
+    FcMutexInit (&config->matchLock);
+    config->matchCache = NULL;
+    config->fontsSerial = 0;
+
     FcRefInit (&config->ref, 1);
 
     return config;
@@ -408,6 +412,9 @@ FcConfigDestroy (FcConfig *config)
 	if (config->fonts[set])
 	    FcFontSetDestroy (config->fonts[set]);
 
+    FcConfigMatchCacheDestroy (config);
+    FcMutexFinish (&config->matchLock);
+
     page = config->expr_pool;
     while (page)
     {
@@ -836,6 +843,7 @@ FcConfigSetFonts (FcConfig	*config,
     if (config->fonts[set])
 	FcFontSetDestroy (config->fonts[set]);
     config->fonts[set] = fonts;
+    config->fontsSerial++;
 }
 
 
@@ -516,6 +516,8 @@ struct _FcAtomic {
     FcChar8	*tmp;		/* tmpfile name (used for locking) */
 };
 
+typedef struct _FcMatchCacheEntry FcMatchCacheEntry;
+
 struct _FcConfig {
     /*
      * File names loaded from the configuration -- saved here as the
@@ -564,6 +566,14 @@ struct _FcConfig {
      * match preferrentially
      */
     FcFontSet	*fonts[FcSetApplication + 1];
+    /*
+     * Results of FcFontMatch keyed on the substituted query pattern.
+     * fontsSerial changes whenever one of the font sets is replaced,
+     * which invalidates every entry.
+     */
+    FcMutex	matchLock;	    /* protects matchCache */
+    FcMatchCacheEntry	*matchCache;
+    unsigned int	fontsSerial;
     /*
      * Fontconfig can periodically rescan the system configuration
      * and font directories.  This rescanning occurs when font
@@ -1037,6 +1047,9 @@ FcListPatternMatchAny (const FcPattern *p,
 
 /* fcmatch.c */
 
+FcPrivate void
+FcConfigMatchCacheDestroy (FcConfig *config);
+
 /* fcname.c */
 
 enum {
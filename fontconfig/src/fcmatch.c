@@ -970,6 +970,181 @@ FcFontSetMatchInternal (FcFontSet   **sets,
     return best;
 }
 
+/*
+ * Clients built on Xft issue the same handful of queries over and over,
+ * and every FcFontMatch scores each font in the configuration.  Remember
+ * which font won for recent queries; the entry is only trusted while
+ * the configuration's font sets are unchanged.
+ */
+#define FC_MATCH_CACHE_BITS	8
+#define FC_MATCH_CACHE_SIZE	(1 << FC_MATCH_CACHE_BITS)
+#define FcMatchCacheSlot(hash)	((hash) >> (32 - FC_MATCH_CACHE_BITS))
+
+struct _FcMatchCacheEntry {
+    FcChar32	    hash;
+    FcPattern	    *pattern;	/* private copy of the query */
+    FcPattern	    *best;	/* owned by one of the config's font sets */
+    unsigned int    serial;
+    int		    nfont[FcSetApplication + 1];
+};
+
+#define FC_FNV_PRIME	16777619U
+
+static FcChar32
+FcMatchCacheMix (FcChar32 h, const void *data, size_t len)
+{
+    const FcChar8   *c = data;
+
+    while (len--)
+	h = (h ^ *c++) * FC_FNV_PRIME;
+    return h;
+}
+
+/*
+ * FcPatternHash folds values with rotate and xor, so similar family
+ * names collide ("Family 0" to "Family 999" give 102 distinct string
+ * hashes) and its low bits are poorly mixed.  Key the cache on an FNV-1a
+ * hash of the objects, bindings and plain values instead; values of the
+ * other types are left to FcMatchCachePatternEqual.
+ */
+static FcChar32
+FcMatchCacheHash (const FcPattern *p)
+{
+    FcPatternElt    *pe = FcPatternElts (p);
+    FcValueListPtr  l;
+    const FcChar8   *s;
+    FcChar32	    h = 2166136261U;
+    int		    i;
+
+    for (i = 0; i < p->num; i++)
+    {
+	h = FcMatchCacheMix (h, &pe[i].object, sizeof (pe[i].object));
+	for (l = FcPatternEltValues (&pe[i]); l; l = FcValueListNext (l))
+	{
+	    h = FcMatchCacheMix (h, &l->binding, sizeof (l->binding));
+	    h = FcMatchCacheMix (h, &l->value.type, sizeof (l->value.type));
+	    switch ((int) l->value.type) {
+	    case FcTypeInteger:
+		h = FcMatchCacheMix (h, &l->value.u.i, sizeof (l->value.u.i));
+		break;
+	    case FcTypeDouble:
+		h = FcMatchCacheMix (h, &l->value.u.d, sizeof (l->value.u.d));
+		break;
+	    case FcTypeBool:
+		h = FcMatchCacheMix (h, &l->value.u.b, sizeof (l->value.u.b));
+		break;
+	    case FcTypeString:
+		s = FcValueString (&l->value);
+		h = FcMatchCacheMix (h, s, strlen ((const char *) s));
+		break;
+	    default:
+		break;
+	    }
+	}
+    }
+    return h;
+}
+
+static int
+FcMatchCacheSetSize (FcConfig *config, FcSetName set)
+{
+    return config->fonts[set] ? config->fonts[set]->nfont : -1;
+}
+
+/*
+ * FcPatternEqual ignores value bindings, but they take part in
+ * family scoring
+ */
+static FcBool
+FcMatchCachePatternEqual (const FcPattern *pa, const FcPattern *pb)
+{
+    FcValueListPtr  la, lb;
+    int		    i;
+
+    if (!FcPatternEqual (pa, pb))
+	return FcFalse;
+    for (i = 0; i < pa->num; i++)
+    {
+	la = FcPatternEltValues (&FcPatternElts (pa)[i]);
+	lb = FcPatternEltValues (&FcPatternElts (pb)[i]);
+	for (; la && lb; la = FcValueListNext (la), lb = FcValueListNext (lb))
+	    if (la->binding != lb->binding)
+		return FcFalse;
+    }
+    return FcTrue;
+}
+
+static FcPattern *
+FcMatchCacheLookup (FcConfig *config, FcPattern *p, FcChar32 hash)
+{
+    FcMatchCacheEntry	*e;
+    FcPattern		*best = NULL;
+    FcSetName		set;
+
+    FcMutexLock (&config->matchLock);
+    if (!config->matchCache)
+	goto bail;
+    e = &config->matchCache[FcMatchCacheSlot (hash)];
+    if (!e->pattern || e->hash != hash || e->serial != config->fontsSerial)
+	goto bail;
+    for (set = FcSetSystem; set <= FcSetApplication; set++)
+	if (e->nfont[set] != FcMatchCacheSetSize (config, set))
+	    goto bail;
+    if (FcMatchCachePatternEqual (e->pattern, p))
+	best = e->best;
+bail:
+    FcMutexUnlock (&config->matchLock);
+
+    return best;
+}
+
+static void
+FcMatchCacheInsert (FcConfig *config, FcPattern *p, FcChar32 hash, FcPattern *best)
+{
+    FcMatchCacheEntry	*e;
+    FcPattern		*copy, *old = NULL;
+    FcSetName		set;
+
+    copy = FcPatternDuplicate (p);
+    if (!copy)
+	return;
+
+    FcMutexLock (&config->matchLock);
+    if (!config->matchCache)
+	config->matchCache = calloc (FC_MATCH_CACHE_SIZE, sizeof (FcMatchCacheEntry));
+    if (config->matchCache)
+    {
+	e = &config->matchCache[FcMatchCacheSlot (hash)];
+	old = e->pattern;
+	e->hash = hash;
+	e->pattern = copy;
+	e->best = best;
+	e->serial = config->fontsSerial;
+	for (set = FcSetSystem; set <= FcSetApplication; set++)
+	    e->nfont[set] = FcMatchCacheSetSize (config, set);
+    }
+    else
+	old = copy;
+    FcMutexUnlock (&config->matchLock);
+
+    if (old)
+	FcPatternDestroy (old);
+}
+
+void
+FcConfigMatchCacheDestroy (FcConfig *config)
+{
+    int	    i;
+
+    if (!config->matchCache)
+	return;
+    for (i = 0; i < FC_MATCH_CACHE_SIZE; i++)
+	if (config->matchCache[i].pattern)
+	    FcPatternDestroy (config->matchCache[i].pattern);
+    free (config->matchCache);
+    config->matchCache = NULL;
+}
+
 FcPattern *
 FcFontSetMatch (FcConfig    *config,
 		FcFontSet   **sets,
@@ -1005,6 +1180,8 @@ FcFontMatch (FcConfig	*config,
     FcFontSet	*sets[2];
     int		nsets;
     FcPattern   *best, *ret = NULL;
+    FcChar32	hash = 0;
+    FcBool	cacheable;
 
     assert (p != NULL);
     assert (result != NULL);
@@ -1020,7 +1197,22 @@ FcFontMatch (FcConfig	*config,
     if (config->fonts[FcSetApplication])
 	sets[nsets++] = config->fonts[FcSetApplication];
 
-    best = FcFontSetMatchInternal (sets, nsets, p, result);
+    /* keep the debug output of the match itself */
+    cacheable = !(FcDebug () & (FC_DBG_MATCH | FC_DBG_MATCHV | FC_DBG_MATCH2));
+    best = NULL;
+    if (cacheable)
+    {
+	hash = FcMatchCacheHash (p);
+	best = FcMatchCacheLookup (config, p, hash);
+    }
+    if (best)
+	*result = FcResultMatch;
+    else
+    {
+	best = FcFontSetMatchInternal (sets, nsets, p, result);
+	if (best && cacheable)
+	    FcMatchCacheInsert (config, p, hash, best);
+    }
     if (best)
 	ret = FcFontRenderPrepare (config, p, best);
 
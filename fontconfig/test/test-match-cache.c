@@ -0,0 +1,80 @@
+/*
+ * fontconfig/test/test-match-cache.c
+ *
+ * Copyright © 2000 Keith Packard
+ *
+ * Permission to use, copy, modify, distribute, and sell this software and its
+ * documentation for any purpose is hereby granted without fee, provided that
+ * the above copyright notice appear in all copies and that both that
+ * copyright notice and this permission notice appear in supporting
+ * documentation, and that the name of the author(s) not be used in
+ * advertising or publicity pertaining to distribution of the software without
+ * specific, written prior permission.  The authors make no
+ * representations about the suitability of this software for any purpose.  It
+ * is provided "as is" without express or implied warranty.
+ *
+ * THE AUTHOR(S) DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN NO
+ * EVENT SHALL THE AUTHOR(S) BE LIABLE FOR ANY SPECIAL, INDIRECT OR
+ * CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE,
+ * DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <stdio.h>
+#include <fontconfig/fontconfig.h>
+
+static int
+check (FcConfig *cfg, double expected)
+{
+    FcPattern *pat = FcNameParse ((const FcChar8 *) "Fixed:pixelsize=16");
+    FcPattern *match;
+    FcResult result;
+    double size;
+    int ret = 1;
+
+    match = FcFontMatch (cfg, pat, &result);
+    if (!match || result != FcResultMatch)
+	fprintf (stderr, "no match\n");
+    else if (FcPatternGetDouble (match, FC_PIXEL_SIZE, 0, &size) != FcResultMatch)
+	fprintf (stderr, "match has no pixel size\n");
+    else if (size != expected)
+	fprintf (stderr, "got pixel size %g, expected %g\n", size, expected);
+    else
+	ret = 0;
+
+    if (match)
+	FcPatternDestroy (match);
+    FcPatternDestroy (pat);
+
+    return ret;
+}
+
+int
+main (void)
+{
+    FcConfig *cfg = FcConfigCreate ();
+    int ret = 0;
+
+    if (!FcConfigAppFontAddFile (cfg, (const FcChar8 *) SRCDIR "/4x6.pcf"))
+	return 77;
+
+    /* repeated queries must keep giving the same answer */
+    ret |= check (cfg, 6);
+    ret |= check (cfg, 6);
+
+    /* a font added to the current set is seen by later queries */
+    if (!FcConfigAppFontAddFile (cfg, (const FcChar8 *) SRCDIR "/8x16.pcf"))
+	return 77;
+    ret |= check (cfg, 16);
+
+    /* so is a replaced set, even one of the same size */
+    FcConfigAppFontClear (cfg);
+    if (!FcConfigAppFontAddFile (cfg, (const FcChar8 *) SRCDIR "/4x6.pcf"))
+	return 77;
+    ret |= check (cfg, 6);
+
+    FcConfigDestroy (cfg);
+
+    return ret;
+}
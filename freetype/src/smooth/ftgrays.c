@@ -1230,11 +1230,12 @@ typedef ptrdiff_t  FT_PtrDist;
   }
 
 
-  static void
-  gray_hline( RAS_ARG_ TCoord  x,
-                       TCoord  y,
-                       TArea   coverage,
-                       TCoord  acount )
+  /* maximum number of spans passed to `render_span' in one call */
+#define FT_MAX_GRAY_SPANS  16
+
+
+  static unsigned char
+  gray_coverage( RAS_ARG_ TArea  coverage )
   {
     /* scale the coverage from 0..(ONE_PIXEL*ONE_PIXEL*2) to 0..256  */
     coverage >>= PIXEL_BITS * 2 + 1 - 8;
@@ -1256,40 +1257,36 @@ typedef ptrdiff_t  FT_PtrDist;
         coverage = 255;
     }
 
-    if ( ras.render_span )  /* for FT_RASTER_FLAG_DIRECT only */
-    {
-      FT_Span  span;
-
+    return (unsigned char)coverage;
+  }
 
-      span.x        = (short)x;
-      span.len      = (unsigned short)acount;
-      span.coverage = (unsigned char)coverage;
 
-      ras.render_span( y, 1, &span, ras.render_span_data );
-    }
-    else
-    {
-      unsigned char*  q = ras.target.origin - ras.target.pitch * y + x;
-      unsigned char   c = (unsigned char)coverage;
+  static void
+  gray_hline( RAS_ARG_ TCoord  x,
+                       TCoord  y,
+                       TArea   coverage,
+                       TCoord  acount )
+  {
+    unsigned char*  q = ras.target.origin - ras.target.pitch * y + x;
+    unsigned char   c = gray_coverage( RAS_VAR_ coverage );
 
 
-      /* For small-spans it is faster to do it by ourselves than
-       * calling `memset'.  This is mainly due to the cost of the
-       * function call.
-       */
-      switch ( acount )
-      {
-      case 7: *q++ = c;
-      case 6: *q++ = c;
-      case 5: *q++ = c;
-      case 4: *q++ = c;
-      case 3: *q++ = c;
-      case 2: *q++ = c;
-      case 1: *q   = c;
-      case 0: break;
-      default:
-        FT_MEM_SET( q, c, acount );
-      }
+    /* For small-spans it is faster to do it by ourselves than
+     * calling `memset'.  This is mainly due to the cost of the
+     * function call.
+     */
+    switch ( acount )
+    {
+    case 7: *q++ = c;
+    case 6: *q++ = c;
+    case 5: *q++ = c;
+    case 4: *q++ = c;
+    case 3: *q++ = c;
+    case 2: *q++ = c;
+    case 1: *q   = c;
+    case 0: break;
+    default:
+      FT_MEM_SET( q, c, acount );
     }
   }
 
@@ -1328,6 +1325,76 @@ typedef ptrdiff_t  FT_PtrDist;
   }
 
 
+  /* Same as `gray_sweep', but for FT_RASTER_FLAG_DIRECT: the spans of */
+  /* a scanline are collected and handed to `render_span' in batches   */
+  /* rather than one call per span.                                    */
+
+  static void
+  gray_sweep_direct( RAS_ARG )
+  {
+    FT_Span  span[FT_MAX_GRAY_SPANS];
+    int      n;
+    int      y;
+
+
+    for ( y = ras.min_ey; y < ras.max_ey; y++ )
+    {
+      PCell   cell  = ras.ycells[y - ras.min_ey];
+      TCoord  x     = ras.min_ex;
+      TArea   cover = 0;
+      TArea   area;
+
+
+      n = 0;
+
+      for ( ; cell != NULL; cell = cell->next )
+      {
+        if ( cover != 0 && cell->x > x )
+        {
+          span[n].x        = (short)x;
+          span[n].len      = (unsigned short)( cell->x - x );
+          span[n].coverage = gray_coverage( RAS_VAR_ cover );
+
+          if ( ++n == FT_MAX_GRAY_SPANS )
+          {
+            ras.render_span( y, n, span, ras.render_span_data );
+            n = 0;
+          }
+        }
+
+        cover += (TArea)cell->cover * ( ONE_PIXEL * 2 );
+        area   = cover - cell->area;
+
+        if ( area != 0 && cell->x >= ras.min_ex )
+        {
+          span[n].x        = (short)cell->x;
+          span[n].len      = 1;
+          span[n].coverage = gray_coverage( RAS_VAR_ area );
+
+          if ( ++n == FT_MAX_GRAY_SPANS )
+          {
+            ras.render_span( y, n, span, ras.render_span_data );
+            n = 0;
+          }
+        }
+
+        x = cell->x + 1;
+      }
+
+      if ( cover != 0 )
+      {
+        span[n].x        = (short)x;
+        span[n].len      = (unsigned short)( ras.max_ex - x );
+        span[n].coverage = gray_coverage( RAS_VAR_ cover );
+        n++;
+      }
+
+      if ( n )
+        ras.render_span( y, n, span, ras.render_span_data );
+    }
+  }
+
+
 #ifdef STANDALONE_
 
   /*************************************************************************/
@@ -1794,7 +1861,10 @@ typedef ptrdiff_t  FT_PtrDist;
 
         if ( !error )
         {
-          gray_sweep( RAS_VAR );
+          if ( ras.render_span )
+            gray_sweep_direct( RAS_VAR );
+          else
+            gray_sweep( RAS_VAR );
           band--;
           continue;
         }
@@ -899,6 +899,202 @@
   }
 
 
+  static void
+  tt_prep_key_init( TT_Size         size,
+                    TT_ExecContext  exec,
+                    FT_Bool         pedantic,
+                    TT_PrepKeyRec*  key )
+  {
+    TT_Driver  driver = (TT_Driver)size->root.face->driver;
+
+
+    FT_ZERO( key );
+
+    key->scale      = size->ttmetrics.scale;
+    key->x_scale    = size->metrics->x_scale;
+    key->y_scale    = size->metrics->y_scale;
+    key->x_ratio    = size->ttmetrics.x_ratio;
+    key->y_ratio    = size->ttmetrics.y_ratio;
+    key->point_size = size->point_size;
+    key->ppem       = size->ttmetrics.ppem;
+    key->x_ppem     = size->metrics->x_ppem;
+    key->y_ppem     = size->metrics->y_ppem;
+
+    key->interpreter_version = driver->interpreter_version;
+
+    key->pedantic  = pedantic;
+    key->rotated   = size->ttmetrics.rotated;
+    key->stretched = size->ttmetrics.stretched;
+    key->grayscale = exec->grayscale;
+
+#ifdef TT_SUPPORT_SUBPIXEL_HINTING_MINIMAL
+    key->subpixel_hinting_lean = exec->subpixel_hinting_lean;
+    key->grayscale_cleartype   = exec->grayscale_cleartype;
+    key->vertical_lcd_lean     = exec->vertical_lcd_lean;
+#endif
+  }
+
+
+  /* The cache is not used if the `prep' inputs can change behind our */
+  /* back: the CVT of variation fonts follows the design coordinates, */
+  /* and the Infinality interpreter tweaks its state per glyph.       */
+  static FT_Bool
+  tt_size_can_cache_prep( TT_Size  size )
+  {
+    TT_Face    face   = (TT_Face)size->root.face;
+    TT_Driver  driver = (TT_Driver)face->root.driver;
+
+
+    if ( FT_HAS_MULTIPLE_MASTERS( &face->root )                 ||
+         driver->interpreter_version == TT_INTERPRETER_VERSION_38 ||
+         face->interpreter != (TT_Interpreter)TT_RunIns         )
+      return FALSE;
+
+    return TRUE;
+  }
+
+
+  static void
+  tt_prep_cache_entry_done( FT_Memory         memory,
+                            TT_PrepCacheRec*  entry )
+  {
+    FT_FREE( entry->cvt );
+    FT_FREE( entry->storage );
+    FT_FREE( entry->twilight_org );
+    FT_FREE( entry->twilight_cur );
+    FT_FREE( entry->twilight_tags );
+    FT_FREE( entry->function_defs );
+    FT_FREE( entry->instruction_defs );
+
+    entry->valid = FALSE;
+  }
+
+
+  static void
+  tt_size_done_prep_cache( TT_Size  size )
+  {
+    FT_Memory  memory = size->root.face->memory;
+    FT_UInt    i;
+
+
+    for ( i = 0; i < TT_PREP_CACHE_SIZE; i++ )
+      tt_prep_cache_entry_done( memory, &size->prep_cache[i] );
+
+    size->prep_cache_next = 0;
+  }
+
+
+  /* Restore the state left by a previous `prep' run with the same */
+  /* key.  Return TRUE on a hit.                                   */
+  static FT_Bool
+  tt_size_load_prep( TT_Size         size,
+                     TT_PrepKeyRec*  key )
+  {
+    TT_PrepCacheRec*  entry = NULL;
+    FT_UInt           i;
+
+
+    for ( i = 0; i < TT_PREP_CACHE_SIZE; i++ )
+    {
+      if ( size->prep_cache[i].valid                            &&
+           !ft_memcmp( &size->prep_cache[i].key, key, sizeof ( *key ) ) )
+      {
+        entry = &size->prep_cache[i];
+        break;
+      }
+    }
+
+    if ( !entry )
+      return FALSE;
+
+    FT_ARRAY_COPY( size->cvt, entry->cvt, size->cvt_size );
+    FT_ARRAY_COPY( size->storage, entry->storage, size->storage_size );
+
+    size->twilight.n_points = entry->twilight_n_points;
+    FT_ARRAY_COPY( size->twilight.org, entry->twilight_org,
+                   entry->twilight_n_points );
+    FT_ARRAY_COPY( size->twilight.cur, entry->twilight_cur,
+                   entry->twilight_n_points );
+    FT_ARRAY_COPY( size->twilight.tags, entry->twilight_tags,
+                   entry->twilight_n_points );
+
+    size->num_function_defs = entry->num_function_defs;
+    FT_ARRAY_COPY( size->function_defs, entry->function_defs,
+                   size->max_function_defs );
+    size->num_instruction_defs = entry->num_instruction_defs;
+    FT_ARRAY_COPY( size->instruction_defs, entry->instruction_defs,
+                   size->max_instruction_defs );
+    size->max_func = entry->max_func;
+    size->max_ins  = entry->max_ins;
+
+    size->GS = entry->GS;
+
+    return TRUE;
+  }
+
+
+  /* Remember the state left by a successful `prep' run.  Failing to */
+  /* allocate an entry is not an error; the program is simply re-run */
+  /* next time.                                                      */
+  static void
+  tt_size_save_prep( TT_Size         size,
+                     TT_PrepKeyRec*  key )
+  {
+    FT_Memory         memory = size->root.face->memory;
+    TT_PrepCacheRec*  entry;
+    FT_UShort         n_twilight = size->twilight.max_points;
+    FT_Error          error;
+
+
+    entry = &size->prep_cache[size->prep_cache_next];
+    size->prep_cache_next = ( size->prep_cache_next + 1 ) %
+                            TT_PREP_CACHE_SIZE;
+
+    entry->valid = FALSE;
+
+    /* the array sizes are fixed for the lifetime of the bytecode data */
+    if ( !entry->cvt && !entry->storage && !entry->twilight_org      &&
+         ( FT_NEW_ARRAY( entry->cvt, size->cvt_size )                  ||
+           FT_NEW_ARRAY( entry->storage, size->storage_size )          ||
+           FT_NEW_ARRAY( entry->twilight_org, n_twilight )             ||
+           FT_NEW_ARRAY( entry->twilight_cur, n_twilight )             ||
+           FT_NEW_ARRAY( entry->twilight_tags, n_twilight )            ||
+           FT_NEW_ARRAY( entry->function_defs,
+                         size->max_function_defs )                     ||
+           FT_NEW_ARRAY( entry->instruction_defs,
+                         size->max_instruction_defs )                  ) )
+    {
+      tt_prep_cache_entry_done( memory, entry );
+      return;
+    }
+
+    entry->key = *key;
+    entry->GS  = size->GS;
+
+    FT_ARRAY_COPY( entry->cvt, size->cvt, size->cvt_size );
+    FT_ARRAY_COPY( entry->storage, size->storage, size->storage_size );
+
+    entry->twilight_n_points = size->twilight.n_points;
+    FT_ARRAY_COPY( entry->twilight_org, size->twilight.org,
+                   size->twilight.n_points );
+    FT_ARRAY_COPY( entry->twilight_cur, size->twilight.cur,
+                   size->twilight.n_points );
+    FT_ARRAY_COPY( entry->twilight_tags, size->twilight.tags,
+                   size->twilight.n_points );
+
+    entry->num_function_defs = size->num_function_defs;
+    FT_ARRAY_COPY( entry->function_defs, size->function_defs,
+                   size->max_function_defs );
+    entry->num_instruction_defs = size->num_instruction_defs;
+    FT_ARRAY_COPY( entry->instruction_defs, size->instruction_defs,
+                   size->max_instruction_defs );
+    entry->max_func = size->max_func;
+    entry->max_ins  = size->max_ins;
+
+    entry->valid = TRUE;
+  }
+
+
   /*************************************************************************/
   /*                                                                       */
   /* <Function>                                                            */
@@ -922,10 +1118,25 @@
     TT_Face         face = (TT_Face)size->root.face;
     TT_ExecContext  exec;
     FT_Error        error;
+    TT_PrepKeyRec   key;
+    FT_Bool         cached = FALSE;
+    FT_Bool         cacheable;
 
 
     exec = size->context;
 
+    /* Only runs from the clean state set up by `tt_size_ready_bytecode' */
+    /* (signalled by `cvt_ready' still being unset) can be cached.  The  */
+    /* re-execution in `tt_loader_init' after a rendering mode change    */
+    /* starts from whatever storage, twilight zone, and graphics state   */
+    /* the previous run left behind.                                     */
+    cacheable = size->cvt_ready < 0 && tt_size_can_cache_prep( size );
+    if ( cacheable )
+    {
+      tt_prep_key_init( size, exec, pedantic, &key );
+      cached = tt_size_load_prep( size, &key );
+    }
+
     error = TT_Load_Context( exec, face, size );
     if ( error )
       return error;
@@ -944,7 +1155,12 @@
 
     TT_Clear_CodeRange( exec, tt_coderange_glyph );
 
-    if ( face->cvt_program_size > 0 )
+    if ( cached )
+    {
+      FT_TRACE4(( "Reusing cached `prep' results.\n" ));
+      error = FT_Err_Ok;
+    }
+    else if ( face->cvt_program_size > 0 )
     {
       TT_Goto_CodeRange( exec, tt_coderange_cvt, 0 );
 
@@ -986,6 +1202,9 @@
 
     TT_Save_Context( exec, size );
 
+    if ( cacheable && !cached && !error )
+      tt_size_save_prep( size, &key );
+
     return error;
   }
 
@@ -1003,6 +1222,8 @@
       size->context = NULL;
     }
 
+    tt_size_done_prep_cache( size );
+
     FT_FREE( size->cvt );
     size->cvt_size = 0;
 
@@ -1054,6 +1275,8 @@
       TT_Done_Context( size->context );
     tt_glyphzone_done( &size->twilight );
 
+    tt_size_done_prep_cache( size );
+
     size->bytecode_ready = -1;
     size->cvt_ready      = -1;
 
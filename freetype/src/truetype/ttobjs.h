@@ -268,6 +268,68 @@ FT_BEGIN_HEADER
   } TT_Size_Metrics;
 
 
+#ifdef TT_USE_BYTECODE_INTERPRETER
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* The results of the `prep' program are cached per size object for a   */
+  /* few sets of scaling parameters, so that switching back and forth      */
+  /* between character sizes doesn't re-execute the program every time.   */
+  /*                                                                       */
+#define TT_PREP_CACHE_SIZE  8
+
+  /* everything the `prep' program can observe */
+  typedef struct  TT_PrepKeyRec_
+  {
+    FT_Fixed   scale;
+    FT_Fixed   x_scale;
+    FT_Fixed   y_scale;
+    FT_Long    x_ratio;
+    FT_Long    y_ratio;
+    FT_Long    point_size;
+    FT_UShort  ppem;
+    FT_UShort  x_ppem;
+    FT_UShort  y_ppem;
+    FT_UInt    interpreter_version;
+    FT_Bool    pedantic;
+    FT_Bool    rotated;
+    FT_Bool    stretched;
+    FT_Bool    grayscale;
+    FT_Bool    subpixel_hinting_lean;
+    FT_Bool    grayscale_cleartype;
+    FT_Bool    vertical_lcd_lean;
+
+  } TT_PrepKeyRec;
+
+
+  /* everything the `prep' program can modify */
+  typedef struct  TT_PrepCacheRec_
+  {
+    FT_Bool           valid;
+    TT_PrepKeyRec     key;
+
+    TT_GraphicsState  GS;
+
+    FT_Long*          cvt;
+    FT_Long*          storage;
+
+    FT_UShort         twilight_n_points;
+    FT_Vector*        twilight_org;
+    FT_Vector*        twilight_cur;
+    FT_Byte*          twilight_tags;
+
+    FT_UInt           num_function_defs;
+    TT_DefArray       function_defs;
+    FT_UInt           num_instruction_defs;
+    TT_DefArray       instruction_defs;
+    FT_UInt           max_func;
+    FT_UInt           max_ins;
+
+  } TT_PrepCacheRec;
+
+#endif /* TT_USE_BYTECODE_INTERPRETER */
+
+
   /*************************************************************************/
   /*                                                                       */
   /* TrueType size class.                                                  */
@@ -319,6 +381,9 @@ FT_BEGIN_HEADER
     FT_Error           bytecode_ready;
     FT_Error           cvt_ready;
 
+    TT_PrepCacheRec    prep_cache[TT_PREP_CACHE_SIZE];
+    FT_UInt            prep_cache_next;   /* next entry to replace */
+
 #endif /* TT_USE_BYTECODE_INTERPRETER */
 
   } TT_SizeRec;
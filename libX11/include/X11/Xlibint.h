@@ -1027,6 +1027,10 @@ extern void _XReadPad(
     char*	/* data */,
     long	/* size */
 );
+extern char *_XTakeReplyData(
+    Display*	/* dpy */,
+    long	/* size */
+);
 extern void _XSend(
     Display*		/* dpy */,
     _Xconst char*	/* data */,
@@ -101,7 +101,11 @@ _XimLocalFilter(Display *d, Window w, XEvent *ev, XPointer client_data)
 	XLookupString((XKeyEvent *)ev, buf, sizeof(buf), &keysym, NULL);
     }
 
-    for(t = ic->private.local.context; t; t = b[t].next) {
+    t = ic->private.local.context;
+    if (t == ((Xim)ic->core.im)->private.local.top &&
+	!XimIsTopKey(((Xim)ic->core.im)->private.local.topkeys, keysym))
+	t = 0;
+    for(; t; t = b[t].next) {
 	if(IsModifierKey(b[t].keysym))
 	    anymodifier = True;
 	if(((ev->xkey.state & b[t].modifier_mask) == b[t].modifier) &&
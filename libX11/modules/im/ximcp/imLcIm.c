@@ -622,6 +622,23 @@ _XimCreateDefaultTree(
     Xfree (cachename);
 }
 
+/*
+ * Remember which keysyms start a sequence, so that the filter can pass
+ * other keys through without walking the whole top level of the tree.
+ */
+static void
+_XimSetTopKeys(
+    Xim		im)
+{
+    XimLocalPrivateRec*  private = &im->private.local;
+    DefTree		*b = private->base.tree;
+    DTIndex		 t;
+
+    memset(private->topkeys, 0, sizeof(private->topkeys));
+    for (t = private->top; t; t = b[t].next)
+	XimSetTopKey(private->topkeys, b[t].keysym);
+}
+
 static XIMMethodsRec      Xim_im_local_methods = {
     _XimLocalCloseIM,           /* close */
     _XimLocalSetIMValues,       /* set_values */
@@ -698,6 +715,7 @@ _XimLocalOpenIM(
     private->base.utf8used = 1;
 
     _XimCreateDefaultTree(im);
+    _XimSetTopKeys(im);
 
     im->methods = &Xim_im_local_methods;
     private->current_ic = (XIC)NULL;
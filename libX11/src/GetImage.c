@@ -66,6 +66,7 @@ XImage *XGetImage (
 	xGetImageReply rep;
 	register xGetImageReq *req;
 	char *data;
+	Bool taken = False;
 	unsigned long nbytes;
 	XImage *image;
 	int planes;
@@ -91,7 +92,12 @@ XImage *XGetImage (
 
 	if (rep.length < (INT_MAX >> 2)) {
 	    nbytes = (unsigned long)rep.length << 2;
-	    data = Xmalloc(nbytes);
+	    /* use the reply buffer as image data when we can; it is an
+	     * ordinary malloc'd block, so clients may still free data */
+	    if ((data = _XTakeReplyData(dpy, nbytes)))
+		taken = True;
+	    else
+		data = Xmalloc(nbytes);
 	} else
 	    data = NULL;
 	if (! data) {
@@ -100,7 +106,8 @@ XImage *XGetImage (
 	    SyncHandle();
 	    return (XImage *) NULL;
 	}
-        _XReadPad (dpy, data, nbytes);
+	if (! taken)
+	    _XReadPad (dpy, data, nbytes);
         if (format == XYPixmap) {
 	    image = XCreateImage(dpy, _XVIDtoVisual(dpy, rep.visual),
 		Ones (plane_mask &
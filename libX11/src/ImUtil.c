@@ -818,6 +818,91 @@ static int _XPutPixel1 (
 	}
 }
 
+/*
+ * CopyZPixels
+ *
+ * Copies a rectangle between two ZPixmap images of 8, 16 or 32 bits per
+ * pixel and the same byte order a row at a time, with the same result as
+ * moving each pixel with XGetPixel and XPutPixel: bits above the source
+ * depth are cleared.  The rectangle must lie inside both images.
+ * Returns 0, having copied nothing, when the images don't qualify.
+ *
+ */
+
+static int _XCopyZPixels (
+    XImage *srcimg,
+    int srcx,
+    int srcy,
+    XImage *dstimg,
+    int dstx,
+    int dsty,
+    int width,
+    int height)
+{
+	const unsigned char *src;
+	unsigned char *dst;
+	unsigned char m[4];
+	unsigned long mask;
+	CARD32 v, m32;
+	int bytes, row, i, n;
+
+	if ((srcimg->format != ZPixmap) || (dstimg->format != ZPixmap) ||
+	    (srcimg->bits_per_pixel != dstimg->bits_per_pixel) ||
+	    (srcimg->byte_order != dstimg->byte_order))
+	    return 0;
+	switch (srcimg->bits_per_pixel) {
+	case 8:
+	    if ((srcimg->f.get_pixel != _XGetPixel8) ||
+		(dstimg->f.put_pixel != _XPutPixel8))
+		return 0;
+	    break;
+	case 16:
+	    if ((srcimg->f.get_pixel != _XGetPixel16) ||
+		(dstimg->f.put_pixel != _XPutPixel16))
+		return 0;
+	    break;
+	case 32:
+	    if ((srcimg->f.get_pixel != _XGetPixel32) ||
+		(dstimg->f.put_pixel != _XPutPixel32))
+		return 0;
+	    break;
+	default:
+	    return 0;
+	}
+
+	bytes = srcimg->bits_per_pixel >> 3;
+	if (srcimg->depth < srcimg->bits_per_pixel)
+	    mask = low_bits_table[srcimg->depth];
+	else
+	    mask = ~0UL;
+	/* the mask as the bytes of one pixel, repeated to fill 32 bits */
+	for (i = 0; i < bytes; i++)
+	    m[i] = mask >> ((srcimg->byte_order == MSBFirst) ?
+			    (bytes - 1 - i) << 3 : i << 3);
+	for (i = 0; i < 4; i++)
+	    ((unsigned char *) &m32)[i] = m[i & (bytes - 1)];
+
+	n = width * bytes;
+	for (row = 0; row < height; row++) {
+	    src = (unsigned char *) srcimg->data +
+		(srcy + row) * srcimg->bytes_per_line + srcx * bytes;
+	    dst = (unsigned char *) dstimg->data +
+		(dsty + row) * dstimg->bytes_per_line + dstx * bytes;
+	    if (mask == ~0UL) {
+		memcpy(dst, src, n);
+		continue;
+	    }
+	    for (i = 0; i + 4 <= n; i += 4) {
+		memcpy(&v, src + i, 4);
+		v &= m32;
+		memcpy(dst + i, &v, 4);
+	    }
+	    for (; i < n; i++)
+		dst[i] = src[i] & m[i & (bytes - 1)];
+	}
+	return 1;
+}
+
 /*
  * SubImage
  *
@@ -883,6 +968,11 @@ static XImage *_XSubImage (
 	if (height > ximage->height - y ) height = ximage->height - y;
 	if (width > ximage->width - x ) width = ximage->width - x;
 
+	if ((x >= 0) && (y >= 0) &&
+	    (x <= ximage->width) && (y <= ximage->height) &&
+	    _XCopyZPixels(ximage, x, y, subimage, 0, 0, width, height))
+	    return subimage;
+
 	for (row = y; row < (y + height); row++) {
 	    for (col = x; col < (x + width); col++) {
 		pixel = XGetPixel(ximage, col, row);
@@ -942,6 +1032,12 @@ int _XSetImage(
 	if (srcimg->height < height)
 	    height = srcimg->height;
 
+	if ((startcol < width) && (startrow < height) &&
+	    _XCopyZPixels(srcimg, startcol, startrow, dstimg,
+			  x + startcol, y + startrow,
+			  width - startcol, height - startrow))
+	    return 1;
+
 	/* this is slow, will do better later */
 	for (row = startrow; row < height; row++) {
 	    for (col = startcol; col < width; col++) {
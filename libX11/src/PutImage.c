@@ -130,6 +130,55 @@ _XReverse_Bytes(
 }
 
 
+/*
+ * Converting four bytes at a time as one 32-bit word lets the compiler
+ * turn the loops below into byte swaps or vector shuffles.  Each of these
+ * treats the bytes the same whatever the host byte order is.
+ */
+#define SWAP_NONE	0
+#define SWAP_TWO	1	/* reverse 8-bit units within 16-bit units */
+#define SWAP_FOUR	2	/* reverse 8-bit units within 32-bit units */
+#define SWAP_WORDS	3	/* reverse 16-bit units within 32-bit units */
+
+static inline CARD32
+SwapQuad(CARD32 v, int swap, int bits)
+{
+    if (swap == SWAP_TWO || swap == SWAP_FOUR)
+	v = ((v & 0x00ff00ff) << 8) | ((v >> 8) & 0x00ff00ff);
+    if (swap == SWAP_FOUR || swap == SWAP_WORDS)
+	v = (v << 16) | (v >> 16);
+    if (bits) {
+	v = ((v >> 1) & 0x55555555) | ((v & 0x55555555) << 1);
+	v = ((v >> 2) & 0x33333333) | ((v & 0x33333333) << 2);
+	v = ((v >> 4) & 0x0f0f0f0f) | ((v & 0x0f0f0f0f) << 4);
+    }
+    return v;
+}
+
+/*
+ * Convert the leading multiple of four bytes of length, returning how
+ * many bytes were done; the caller finishes the rest.  Only ever called
+ * with constant swap and bits, so the tests in SwapQuad fold away.
+ */
+static inline long
+SwapQuads(
+    const unsigned char *src,
+    unsigned char *dest,
+    long length,
+    int swap,
+    int bits)
+{
+    long n;
+    CARD32 v;
+
+    for (n = 0; n + 4 <= length; n += 4) {
+	memcpy(&v, src + n, 4);
+	v = SwapQuad(v, swap, bits);
+	memcpy(dest + n, &v, 4);
+    }
+    return n;
+}
+
 /* XXX the following functions are declared int instead of void because various
  * compilers and lints complain about later initialization of SwapFunc and/or
  * (swapfunc == NoSwap) when void is used.
@@ -176,10 +225,12 @@ SwapTwoBytes (
 	    else
 		*(dest + length + 1) = *(src + length);
 	}
-	for (n = length; n > 0; n -= 2, src += 2) {
-	    *dest++ = *(src + 1);
-	    *dest++ = *src;
+	for (n = SwapQuads(src, dest, length, SWAP_TWO, 0); n < length; n += 2) {
+	    dest[n] = src[n + 1];
+	    dest[n + 1] = src[n];
 	}
+	src += length;
+	dest += length;
     }
 }
 
@@ -223,7 +274,7 @@ SwapFourBytes (
     int half_order)
 {
     long length = ROUNDUP(srclen, 4);
-    register long h, n;
+    register long h;
 
     srcinc -= length;
     destinc -= length;
@@ -241,12 +292,9 @@ SwapFourBytes (
 	    if (half_order == LSBFirst)
 		*(dest + length + 3) = *(src + length);
 	}
-	for (n = length; n > 0; n -= 4, src += 4) {
-	    *dest++ = *(src + 3);
-	    *dest++ = *(src + 2);
-	    *dest++ = *(src + 1);
-	    *dest++ = *src;
-	}
+	SwapQuads(src, dest, length, SWAP_FOUR, 0);
+	src += length;
+	dest += length;
     }
 }
 
@@ -259,7 +307,7 @@ SwapWords (
     int half_order)
 {
     long length = ROUNDUP(srclen, 4);
-    register long h, n;
+    register long h;
 
     srcinc -= length;
     destinc -= length;
@@ -277,12 +325,9 @@ SwapWords (
 	    if (half_order == LSBFirst)
 		*(dest + length + 2) = *(src + length);
 	}
-	for (n = length; n > 0; n -= 4, src += 2) {
-	    *dest++ = *(src + 2);
-	    *dest++ = *(src + 3);
-	    *dest++ = *src++;
-	    *dest++ = *src++;
-	}
+	SwapQuads(src, dest, length, SWAP_WORDS, 0);
+	src += length;
+	dest += length;
     }
 }
 
@@ -347,9 +392,12 @@ SwapBits(
 
     srcinc -= srclen;
     destinc -= srclen;
-    for (h = height; --h >= 0; src += srcinc, dest += destinc)
-	for (n = srclen; --n >= 0; )
-	    *dest++ = rev[*src++];
+    for (h = height; --h >= 0; src += srcinc, dest += destinc) {
+	for (n = SwapQuads(src, dest, srclen, SWAP_NONE, 1); n < srclen; n++)
+	    dest[n] = rev[src[n]];
+	src += srclen;
+	dest += srclen;
+    }
 }
 
 static void
@@ -765,6 +765,8 @@ miRegionOp(
 						 * band */
     short     	  	bot;	    	    	/* Bottom of non-overlapping
 						 * band */
+    long		size;			/* Rectangles to allocate */
+    Bool		scratch;		/* newReg is not a source */
 
     /*
      * Initialization:
@@ -777,6 +779,7 @@ miRegionOp(
     r2 = reg2->rects;
     r1End = r1 + reg1->numRects;
     r2End = r2 + reg2->numRects;
+    size = max(reg1->numRects,reg2->numRects) * 2;
 
     oldRects = newReg->rects;
 
@@ -788,12 +791,23 @@ miRegionOp(
      * reallocate and copy the array, which is time consuming, yet we don't
      * have to worry about using too much memory. I hope to be able to
      * nuke the Xrealloc() at the end of this function eventually.
+     *
+     * If the new region is not one of the sources and already has room,
+     * its array is simply reused.
      */
-    newReg->size = max(reg1->numRects,reg2->numRects) * 2;
+    scratch = (newReg != reg1) && (newReg != reg2);
+    if (scratch && (newReg->size >= size))
+    {
+	oldRects = NULL;
+    }
+    else
+    {
+	newReg->size = size;
 
-    if (! (newReg->rects = Xmallocarray (newReg->size, sizeof(BoxRec)))) {
-	newReg->size = 0;
-	return;
+	if (! (newReg->rects = Xmallocarray (newReg->size, sizeof(BoxRec)))) {
+	    newReg->size = 0;
+	    return;
+	}
     }
 
     /*
@@ -975,8 +989,11 @@ miRegionOp(
      *
      * Only do this stuff if the number of rectangles allocated is more than
      * twice the number of rectangles in the region (a simple optimization...).
+     * A destination that is not one of the sources keeps its array, so the
+     * next operation into it can reuse it instead of allocating again; the
+     * array only ever grows as far as a single operation needed.
      */
-    if (newReg->numRects < (newReg->size >> 1))
+    if (!scratch && newReg->numRects < (newReg->size >> 1))
     {
 	if (REGION_NOT_EMPTY(newReg))
 	{
@@ -1140,6 +1157,105 @@ miUnionO (
     return 0;	/* lint */
 }
 
+/*-
+ *-----------------------------------------------------------------------
+ * miRegionAppend --
+ *	Union two regions that don't share any band, regTop lying entirely
+ *	above regBot. The result is regTop's rectangles followed by regBot's,
+ *	with the two bands where they meet coalesced as miRegionOp would.
+ *	newReg may be either of the sources.
+ *
+ * Results:
+ *	TRUE if successful.
+ *
+ * Side Effects:
+ *	newReg is overwritten.
+ *
+ *-----------------------------------------------------------------------
+ */
+static int
+miRegionAppend(
+    register Region	newReg,
+    Region		regTop,
+    Region		regBot)
+{
+    BoxPtr		pTop = regTop->rects;
+    BoxPtr		pBot = regBot->rects;
+    int			numTop = regTop->numRects;
+    int			numBot = regBot->numRects;
+    int			topBand;	/* start of the last band of regTop */
+    int			botBand;	/* end of the first band of regBot */
+    int			skip = 0;	/* regBot rectangles merged away */
+    short		y2 = pBot[0].y2;	/* bottom of the merged band */
+    int			numRects;
+    BoxRec		extents;
+    register int	i;
+
+    topBand = numTop - 1;
+    while ((topBand > 0) && (pTop[topBand - 1].y1 == pTop[numTop - 1].y1))
+	topBand--;
+    botBand = 1;
+    while ((botBand < numBot) && (pBot[botBand].y1 == pBot[0].y1))
+	botBand++;
+
+    if ((pTop[numTop - 1].y2 == pBot[0].y1) &&
+	(numTop - topBand == botBand))
+    {
+	for (i = 0; i < botBand; i++)
+	{
+	    if ((pTop[topBand + i].x1 != pBot[i].x1) ||
+		(pTop[topBand + i].x2 != pBot[i].x2))
+		break;
+	}
+	if (i == botBand)
+	    skip = botBand;
+    }
+
+    numRects = numTop + numBot - skip;
+    extents.x1 = min(regTop->extents.x1, regBot->extents.x1);
+    extents.y1 = regTop->extents.y1;
+    extents.x2 = max(regTop->extents.x2, regBot->extents.x2);
+    extents.y2 = regBot->extents.y2;
+
+    if (newReg->size < numRects)
+    {
+	BoxPtr newRects = Xreallocarray(newReg->rects, numRects * 2,
+					sizeof(BoxRec));
+
+	if (! newRects)
+	    return 0;
+	newReg->rects = newRects;
+	newReg->size = numRects * 2;
+	if (regTop == newReg)
+	    pTop = newRects;
+	if (regBot == newReg)
+	    pBot = newRects;
+    }
+
+    if (regBot == newReg)
+    {
+	memmove(newReg->rects + numTop, pBot + skip,
+		(numBot - skip) * sizeof(BoxRec));
+	memcpy(newReg->rects, pTop, numTop * sizeof(BoxRec));
+    }
+    else
+    {
+	if (regTop != newReg)
+	    memcpy(newReg->rects, pTop, numTop * sizeof(BoxRec));
+	memcpy(newReg->rects + numTop, pBot + skip,
+	       (numBot - skip) * sizeof(BoxRec));
+    }
+    if (skip)
+    {
+	for (i = topBand; i < numTop; i++)
+	    newReg->rects[i].y2 = y2;
+    }
+
+    newReg->numRects = numRects;
+    newReg->extents = extents;
+    return 1;
+}
+
 int
 XUnionRegion(
     Region 	  reg1,
@@ -1196,6 +1312,14 @@ XUnionRegion(
         return 1;
     }
 
+    /*
+     * Regions without a band in common just need to be concatenated
+     */
+    if (reg1->extents.y2 <= reg2->extents.y1)
+	return miRegionAppend(newReg, reg1, reg2);
+    if (reg2->extents.y2 <= reg1->extents.y1)
+	return miRegionAppend(newReg, reg2, reg1);
+
     miRegionOp (newReg, reg1, reg2, miUnionO,
     		miUnionNonO, miUnionNonO);
 
@@ -175,6 +175,21 @@ typedef struct _LTable {
 
 #define LeafHash(le,q) (le)->buckets[(q) & (le)->table.mask]
 
+/* XrmQGetSearchList results are remembered per database, keyed by the
+ * name and class lists, so that asking again for the same widget path
+ * (constraint resources, subresources) skips the tree walk.  A remembered
+ * list is only good for the serial it was computed at; every change to
+ * the database bumps the serial.
+ */
+#define SEARCHCACHE 8
+
+typedef struct _SearchCacheRec {
+    unsigned long	serial;		/* db serial, 0 if unused */
+    int			depth;		/* number of names (and classes) */
+    int			length;		/* search list length, without NULL */
+    LTable		*list;		/* the list, then names and classes */
+} SearchCacheRec, *SearchCache;
+
 /* An XrmDatabase just holds a pointer to the first top-level table.
  * The type name is no longer descriptive, but better to not change
  * the Xresource.h header file.  This type also gets used to define
@@ -185,6 +200,8 @@ typedef struct _XrmHashBucketRec {
     NTable table;
     XPointer mbstate;
     XrmMethods methods;
+    unsigned long serial;
+    SearchCacheRec search_cache[SEARCHCACHE];
 #ifdef XTHREADS
     LockInfoRec linfo;
 #endif
@@ -491,6 +508,18 @@ static const XrmMethodsRec mb_methods = {
 };
 
 
+static void FreeSearchCache(
+    XrmDatabase db)
+{
+    int i;
+
+    for (i = 0; i < SEARCHCACHE; i++) {
+	Xfree(db->search_cache[i].list);
+	db->search_cache[i].list = NULL;
+	db->search_cache[i].serial = 0;
+    }
+}
+
 static XrmDatabase NewDatabase(void)
 {
     register XrmDatabase db;
@@ -499,6 +528,8 @@ static XrmDatabase NewDatabase(void)
     if (db) {
 	_XCreateMutex(&db->linfo);
 	db->table = (NTable)NULL;
+	db->serial = 1;
+	memset(db->search_cache, 0, sizeof(db->search_cache));
 	db->mbstate = (XPointer)NULL;
 	db->methods = _XrmInitParseInfo(&db->mbstate);
 	if (!db->methods)
@@ -798,6 +829,8 @@ void XrmCombineDatabase(
 		    *prev = ftable;
 	    }
 	}
+	(*into)->serial++;
+	FreeSearchCache(from);
 	(from->methods->destroy)(from->mbstate);
 	_XUnlockMutex(&from->linfo);
 	_XFreeMutex(&from->linfo);
@@ -853,6 +886,7 @@ static void PutEntry(
 
     if (!db || !*quarks)
 	return;
+    db->serial++;
     table = *(prev = &db->table);
     /* if already at leaf, bump to the leaf table */
     if (!quarks[1] && table && !table->leaf)
@@ -2252,6 +2286,62 @@ static Bool SearchNEntry(
     return False;
 }
 
+/* find the cache slot for a name and class list, and whether it holds
+ * a current search list for exactly these lists
+ */
+static SearchCache FindSearchList(
+    XrmDatabase		db,
+    XrmNameList		names,
+    XrmClassList	classes,
+    int			*depth,	/* RETURN */
+    Bool		*found)	/* RETURN */
+{
+    register SearchCache cache;
+    register unsigned int hash = 0;
+    register int i;
+    XrmQuark *quarks;
+
+    for (i = 0; names[i]; i++)
+	hash = (hash * 31 + names[i]) * 31 + classes[i];
+    *depth = i;
+    cache = &db->search_cache[hash & (SEARCHCACHE - 1)];
+    *found = False;
+    if (cache->serial != db->serial || cache->depth != i)
+	return cache;
+    quarks = (XrmQuark *)(cache->list + cache->length);
+    for (i = 0; i < cache->depth; i++)
+	if (quarks[i] != names[i] || quarks[cache->depth + i] != classes[i])
+	    return cache;
+    *found = True;
+    return cache;
+}
+
+static void SaveSearchList(
+    XrmDatabase		db,
+    SearchCache		cache,
+    XrmNameList		names,
+    XrmClassList	classes,
+    int			depth,
+    LTable		*list,
+    int			length)
+{
+    LTable *copy;
+    XrmQuark *quarks;
+
+    copy = Xmalloc(length * sizeof(LTable) + 2 * depth * sizeof(XrmQuark));
+    if (!copy)
+	return;
+    memcpy(copy, list, length * sizeof(LTable));
+    quarks = (XrmQuark *)(copy + length);
+    memcpy(quarks, names, depth * sizeof(XrmQuark));
+    memcpy(quarks + depth, classes, depth * sizeof(XrmQuark));
+    Xfree(cache->list);
+    cache->list = copy;
+    cache->serial = db->serial;
+    cache->depth = depth;
+    cache->length = length;
+}
+
 Bool XrmQGetSearchList(
     XrmDatabase     db,
     XrmNameList	    names,
@@ -2261,6 +2351,9 @@ Bool XrmQGetSearchList(
 {
     register NTable	table;
     SClosureRec		closure;
+    SearchCache		cache;
+    int			depth;
+    Bool		found;
 
     if (listLength <= 0)
 	return False;
@@ -2269,6 +2362,18 @@ Bool XrmQGetSearchList(
     closure.limit = listLength - 2;
     if (db) {
 	_XLockMutex(&db->linfo);
+	cache = FindSearchList(db, names, classes, &depth, &found);
+	if (found) {
+	    if (cache->length >= listLength) {
+		_XUnlockMutex(&db->linfo);
+		return False;
+	    }
+	    memcpy(closure.list, cache->list, cache->length * sizeof(LTable));
+	    closure.idx = cache->length - 1;
+	    _XUnlockMutex(&db->linfo);
+	    closure.list[closure.idx + 1] = (LTable)NULL;
+	    return True;
+	}
 	table = db->table;
 	if (*names) {
 	    if (table && !table->leaf) {
@@ -2291,6 +2396,8 @@ Bool XrmQGetSearchList(
 		return False;
 	    }
 	}
+	SaveSearchList(db, cache, names, classes, depth,
+		       closure.list, closure.idx + 1);
 	_XUnlockMutex(&db->linfo);
     }
     closure.list[closure.idx + 1] = (LTable)NULL;
@@ -2658,6 +2765,7 @@ void XrmDestroyDatabase(
 	    else
 		DestroyNTable(table);
 	}
+	FreeSearchCache(db);
 	_XUnlockMutex(&db->linfo);
 	_XFreeMutex(&db->linfo);
 	(*db->methods->destroy)(db->mbstate);
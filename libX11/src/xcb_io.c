@@ -836,6 +836,28 @@ int _XRead(Display *dpy, char *data, long size)
 	return 0;
 }
 
+/*
+ * _XTakeReplyData - Hand the rest of the current reply to the caller
+ * instead of reading it into a new buffer.  size is the number of bytes
+ * the caller would otherwise read with _XReadPad, and must cover
+ * everything left in the reply.  On success those bytes are moved to the
+ * start of the reply block, which is returned and belongs to the caller;
+ * it is an ordinary malloc'd block and may be released with Xfree.
+ * Returns NULL, consuming nothing, when the reply can't be handed over;
+ * the caller should then fall back to _XReadPad.
+ */
+char *_XTakeReplyData(Display *dpy, long size)
+{
+	char *reply = dpy->xcb->reply_data;
+
+	if(reply == NULL || size <= 0 ||
+	   dpy->xcb->reply_length - dpy->xcb->reply_consumed != size + (-size & 3))
+		return NULL;
+	memmove(reply, reply + dpy->xcb->reply_consumed, size);
+	dpy->xcb->reply_data = NULL;
+	return reply;
+}
+
 /*
  * _XReadPad - Read bytes from the socket taking into account incomplete
  * reads.  If the number of bytes is not 0 mod 4, read additional pad
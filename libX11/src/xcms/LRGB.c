@@ -464,8 +464,12 @@ LINEAR_RGB_InitSCCData(
  *
  */
 {
-    Atom  CorrectAtom = XInternAtom (dpy, XDCCC_CORRECT_ATOM_NAME, True);
-    Atom  MatrixAtom  = XInternAtom (dpy, XDCCC_MATRIX_ATOM_NAME, True);
+    static char *atomNames[] = {
+	XDCCC_CORRECT_ATOM_NAME,
+	XDCCC_MATRIX_ATOM_NAME
+    };
+    Atom  atoms[2];
+    Atom  CorrectAtom, MatrixAtom;
     int	  format_return, count, cType, nTables;
     unsigned long nitems, nbytes_return;
     char *property_return, *pChar;
@@ -478,6 +482,13 @@ LINEAR_RGB_InitSCCData(
     LINEAR_RGB_SCCData *pScreenData, *pScreenDefaultData;
     XcmsIntensityMap *pNewMap;
 
+    /*
+     * Look up both property atoms in a single round trip
+     */
+    XInternAtoms (dpy, atomNames, 2, True, atoms);
+    CorrectAtom = atoms[0];
+    MatrixAtom = atoms[1];
+
     /*
      * Allocate memory for pScreenData
      */
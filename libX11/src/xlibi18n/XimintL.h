@@ -44,6 +44,12 @@ typedef INT32  DTIndex;
 typedef INT32  DTCharIndex;
 typedef BITS32 DTModifier;
 
+#define XimTopKeyBit(ks)	(((ks) ^ ((ks) >> 7)) & 0x1ff)
+#define XimSetTopKey(keys, ks) \
+	((keys)[XimTopKeyBit(ks) >> 5] |= (BITS32)1 << (XimTopKeyBit(ks) & 31))
+#define XimIsTopKey(keys, ks) \
+	((keys)[XimTopKeyBit(ks) >> 5] & ((BITS32)1 << (XimTopKeyBit(ks) & 31)))
+
 typedef struct _DefTree {
     DTIndex          next;
     DTIndex          succession;	/* successive Key Sequence */
@@ -82,6 +88,7 @@ typedef struct _XimLocalPrivateRec {
 	XIC		 current_ic;
 	DefTreeBase	 base;
 	DTIndex          top;
+	BITS32		 topkeys[16];	/* keysyms starting a sequence, hashed */
 } XimLocalPrivateRec;
 
 typedef struct _XicThaiPart {
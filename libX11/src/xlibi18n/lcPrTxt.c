@@ -140,14 +140,24 @@ _XTextPropertyToTextList(
     encoding = text_prop->encoding;
     if (encoding == XA_STRING)
 	from_type = XlcNString;
-    else if (encoding == XInternAtom(dpy, "UTF8_STRING", False))
-	from_type = XlcNUtf8String;
-    else if (encoding == XInternAtom(dpy, "COMPOUND_TEXT", False))
-	from_type = XlcNCompoundText;
-    else if (encoding == XInternAtom(dpy, XLC_PUBLIC(lcd, encoding_name), False))
-	from_type = XlcNMultiByte;
-    else
-	return XConverterNotFound;
+    else {
+	char *names[3];
+	Atom atoms[3];
+
+	/* intern the candidate encodings with a single round trip */
+	names[0] = "UTF8_STRING";
+	names[1] = "COMPOUND_TEXT";
+	names[2] = (char *) XLC_PUBLIC(lcd, encoding_name);
+	XInternAtoms(dpy, names, 3, False, atoms);
+	if (encoding == atoms[0])
+	    from_type = XlcNUtf8String;
+	else if (encoding == atoms[1])
+	    from_type = XlcNCompoundText;
+	else if (encoding == atoms[2])
+	    from_type = XlcNMultiByte;
+	else
+	    return XConverterNotFound;
+    }
 
     if (is_wide_char) {
 	buf_len = (text_prop->nitems + 1) * sizeof(wchar_t);
@@ -381,6 +381,30 @@ init_all_charsets (void)
 	    init_all_charsets();					\
     } while (0)
 
+/*
+ * Finds the all_charsets[] entry for a charset's encoding name.  Callers
+ * tend to convert many segments of the same charset in a row, so the
+ * converter remembers the last one in its state.
+ */
+static Utf8Conv
+lookup_charset_conv(
+    XlcConv conv,
+    const char *name)
+{
+    Utf8Conv convptr = (Utf8Conv) conv->state;
+    int i;
+
+    if (convptr != NULL && !strcmp(convptr->name, name))
+	return convptr;
+    for (convptr = all_charsets, i = all_charsets_count-1; i > 0; convptr++, i--)
+	if (!strcmp(convptr->name, name))
+	    break;
+    if (i == 0)
+	return NULL;
+    conv->state = (XPointer) convptr;
+    return convptr;
+}
+
 /* from XlcNCharSet to XlcNUtf8String */
 
 static int
@@ -396,7 +420,6 @@ cstoutf8(
     XlcCharSet charset;
     const char *name;
     Utf8Conv convptr;
-    int i;
     unsigned char const *src;
     unsigned char const *srcend;
     unsigned char *dst;
@@ -413,10 +436,8 @@ cstoutf8(
     name = charset->encoding_name;
     /* not charset->name because the latter has a ":GL"/":GR" suffix */
 
-    for (convptr = all_charsets, i = all_charsets_count-1; i > 0; convptr++, i--)
-	if (!strcmp(convptr->name, name))
-	    break;
-    if (i == 0)
+    convptr = lookup_charset_conv(conv, name);
+    if (convptr == NULL)
 	return -1;
 
     src = (unsigned char const *) *from;
@@ -824,6 +845,14 @@ utf8tostr(
 	ucs4_t wc;
 	int consumed;
 
+	/* ASCII maps to itself */
+	if (*src < 0x80) {
+	    if (dst == dstend)
+		break;
+	    *dst++ = *src++;
+	    continue;
+	}
+
 	consumed = utf8_mbtowc(NULL, &wc, src, srcend-src);
 	if (consumed == RET_TOOFEW(0))
 	    break;
@@ -894,7 +923,17 @@ strtoutf8(
     dstend = dst + *to_left;
 
     while (src < srcend) {
-	int count = utf8_wctomb(NULL, dst, *src, dstend-dst);
+	int count;
+
+	/* ASCII maps to itself */
+	if (*src < 0x80) {
+	    if (dst == dstend)
+		break;
+	    *dst++ = *src++;
+	    continue;
+	}
+
+	count = utf8_wctomb(NULL, dst, *src, dstend-dst);
 	if (count == RET_TOOSMALL)
 	    break;
 	dst += count;
@@ -1178,7 +1217,15 @@ utf8towcs(
 
     while (src < srcend && dst < dstend) {
 	ucs4_t wc;
-	int consumed = utf8_mbtowc(NULL, &wc, src, srcend-src);
+	int consumed;
+
+	/* ASCII maps to itself */
+	if (*src < 0x80) {
+	    *dst++ = *src++;
+	    continue;
+	}
+
+	consumed = utf8_mbtowc(NULL, &wc, src, srcend-src);
 	if (consumed == RET_TOOFEW(0))
 	    break;
 	if (consumed == RET_ILSEQ) {
@@ -1244,7 +1291,17 @@ wcstoutf8(
     unconv_num = 0;
 
     while (src < srcend) {
-	int count = utf8_wctomb(NULL, dst, *src, dstend-dst);
+	int count;
+
+	/* ASCII maps to itself */
+	if ((ucs4_t) *src < 0x80) {
+	    if (dst == dstend)
+		break;
+	    *dst++ = (unsigned char) *src++;
+	    continue;
+	}
+
+	count = utf8_wctomb(NULL, dst, *src, dstend-dst);
 	if (count == RET_TOOSMALL)
 	    break;
 	if (count == RET_ILSEQ) {
@@ -1410,7 +1467,6 @@ cstowcs(
     XlcCharSet charset;
     const char *name;
     Utf8Conv convptr;
-    int i;
     unsigned char const *src;
     unsigned char const *srcend;
     wchar_t *dst;
@@ -1427,10 +1483,8 @@ cstowcs(
     name = charset->encoding_name;
     /* not charset->name because the latter has a ":GL"/":GR" suffix */
 
-    for (convptr = all_charsets, i = all_charsets_count-1; i > 0; convptr++, i--)
-	if (!strcmp(convptr->name, name))
-	    break;
-    if (i == 0)
+    convptr = lookup_charset_conv(conv, name);
+    if (convptr == NULL)
 	return -1;
 
     src = (unsigned char const *) *from;
@@ -1827,7 +1881,6 @@ iconv_cstombs(XlcConv conv, XPointer *from, int *from_left,
     XlcCharSet charset;
     char const *name;
     Utf8Conv convptr;
-    int i;
     unsigned char const *src;
     unsigned char const *srcend;
     unsigned char *dst;
@@ -1844,10 +1897,8 @@ iconv_cstombs(XlcConv conv, XPointer *from, int *from_left,
     name = charset->encoding_name;
     /* not charset->name because the latter has a ":GL"/":GR" suffix */
 
-    for (convptr = all_charsets, i = all_charsets_count-1; i > 0; convptr++, i--)
-	if (!strcmp(convptr->name, name))
-	    break;
-    if (i == 0)
+    convptr = lookup_charset_conv(conv, name);
+    if (convptr == NULL)
 	return -1;
 
     src = (unsigned char const *) *from;
@@ -106,6 +106,8 @@ typedef struct _FontTable {
     int		    size;
     FontEntryPtr    entries;
     Bool	    sorted;
+    struct _FontFieldIndex *index;	/* XLFD field index, built on demand */
+    Bool	    index_failed;	/* building index ran out of memory */
 } FontTableRec;
 
 typedef struct _FontDirectory {
@@ -137,6 +137,23 @@ FT_Library ftypeLibrary;
 
 static FTFacePtr faceTable[NUMFACEBUCKETS];
 
+/*
+ * Instances whose last font has been closed are kept, rasterised glyphs
+ * and all, because clients keep reopening the same XLFDs.  They stay on
+ * their face's instance list, so FreeTypeOpenInstance finds them like
+ * any other; this list only orders them for eviction.
+ */
+#define FT_RETIRED_MAX_INSTANCES 64
+#define FT_RETIRED_MAX_BYTES (4 * 1024 * 1024)
+
+static FTInstancePtr retiredInstances;  /* most recently closed first */
+static int retiredCount;
+static unsigned long retiredBytes;
+static unsigned long instanceHits, instanceMisses;
+static unsigned long glyphHits, glyphMisses;
+
+static void FreeTypeReviveInstance(FTInstancePtr instance);
+
 static unsigned
 hash(char *string)
 {
@@ -407,18 +424,25 @@ FreeTypeOpenInstance(FTInstancePtr *instance_return, FTFacePtr face,
     }
     if(otherInstance) {
         MUMBLE("Returning cached instance\n");
+        if(otherInstance->refcount == 0) {
+            FreeTypeReviveInstance(otherInstance);
+            instanceHits++;
+        }
         otherInstance->refcount++;
         *instance_return = otherInstance;
         return Successful;
     }
 
     /* None matching found */
+    instanceMisses++;
     instance = malloc(sizeof(FTInstanceRec));
     if(instance == NULL) {
         return AllocError;
     }
 
     instance->refcount = 1;
+    instance->glyphBytes = 0;
+    instance->retiredNext = NULL;
     instance->face = face;
 
     instance->load_flags = load_flags;
@@ -537,60 +561,117 @@ FreeTypeOpenInstance(FTInstancePtr *instance_return, FTFacePtr face,
 }
 
 static void
-FreeTypeFreeInstance(FTInstancePtr instance)
+FreeTypeDestroyInstance(FTInstancePtr instance)
 {
     FTInstancePtr otherInstance;
-
-    if( instance == NULL ) return;
+    int i,j;
 
     if(instance->face->active_instance == instance)
         instance->face->active_instance = NULL;
-    instance->refcount--;
-    if(instance->refcount <= 0) {
-        int i,j;
 
-        if(instance->face->instances == instance)
-            instance->face->instances = instance->next;
-        else {
-            for(otherInstance = instance->face->instances;
-                otherInstance;
-                otherInstance = otherInstance->next)
-                if(otherInstance->next == instance) {
-                    otherInstance->next = instance->next;
-                    break;
-                }
-        }
+    if(instance->face->instances == instance)
+        instance->face->instances = instance->next;
+    else {
+        for(otherInstance = instance->face->instances;
+            otherInstance;
+            otherInstance = otherInstance->next)
+            if(otherInstance->next == instance) {
+                otherInstance->next = instance->next;
+                break;
+            }
+    }
 
-        FT_Done_Size(instance->size);
-        FreeTypeFreeFace(instance->face);
+    FT_Done_Size(instance->size);
+    FreeTypeFreeFace(instance->face);
 
-        if(instance->charcellMetrics) {
-            free(instance->charcellMetrics);
-        }
-        if(instance->forceConstantMetrics) {
-            free(instance->forceConstantMetrics);
-        }
-        if(instance->glyphs) {
-            for(i = 0; i < iceil(instance->nglyphs, FONTSEGMENTSIZE); i++) {
-                if(instance->glyphs[i]) {
-                    for(j = 0; j < FONTSEGMENTSIZE; j++) {
-                        if(instance->available[i][j] ==
-                           FT_AVAILABLE_RASTERISED)
-                            free(instance->glyphs[i][j].bits);
-                    }
-                    free(instance->glyphs[i]);
+    if(instance->charcellMetrics) {
+        free(instance->charcellMetrics);
+    }
+    if(instance->forceConstantMetrics) {
+        free(instance->forceConstantMetrics);
+    }
+    if(instance->glyphs) {
+        for(i = 0; i < iceil(instance->nglyphs, FONTSEGMENTSIZE); i++) {
+            if(instance->glyphs[i]) {
+                for(j = 0; j < FONTSEGMENTSIZE; j++) {
+                    if(instance->available[i][j] ==
+                       FT_AVAILABLE_RASTERISED)
+                        free(instance->glyphs[i][j].bits);
                 }
+                free(instance->glyphs[i]);
             }
-            free(instance->glyphs);
         }
-        if(instance->available) {
-            for(i = 0; i < iceil(instance->nglyphs, FONTSEGMENTSIZE); i++) {
-                if(instance->available[i])
-                    free(instance->available[i]);
-            }
-            free(instance->available);
+        free(instance->glyphs);
+    }
+    if(instance->available) {
+        for(i = 0; i < iceil(instance->nglyphs, FONTSEGMENTSIZE); i++) {
+            if(instance->available[i])
+                free(instance->available[i]);
+        }
+        free(instance->available);
+    }
+    free(instance);
+}
+
+static void
+FreeTypeReviveInstance(FTInstancePtr instance)
+{
+    FTInstancePtr *prev;
+
+    for(prev = &retiredInstances; *prev; prev = &(*prev)->retiredNext) {
+        if(*prev == instance) {
+            *prev = instance->retiredNext;
+            instance->retiredNext = NULL;
+            retiredCount--;
+            retiredBytes -= instance->glyphBytes;
+            return;
         }
-        free(instance);
+    }
+}
+
+static void
+FreeTypeRetireInstance(FTInstancePtr instance)
+{
+    FTInstancePtr *prev;
+
+    instance->retiredNext = retiredInstances;
+    retiredInstances = instance;
+    retiredCount++;
+    retiredBytes += instance->glyphBytes;
+
+    /* Drop the least recently closed instances until we are within bounds */
+    while(retiredCount > FT_RETIRED_MAX_INSTANCES ||
+          retiredBytes > FT_RETIRED_MAX_BYTES) {
+        for(prev = &retiredInstances; (*prev)->retiredNext;
+            prev = &(*prev)->retiredNext)
+            ;
+        instance = *prev;
+        *prev = NULL;
+        retiredCount--;
+        retiredBytes -= instance->glyphBytes;
+        MUMBLE("Evicting instance: %lu/%lu instance hits, "
+               "%lu/%lu glyph hits\n",
+               instanceHits, instanceHits + instanceMisses,
+               glyphHits, glyphHits + glyphMisses);
+        FreeTypeDestroyInstance(instance);
+    }
+}
+
+static void
+FreeTypeFreeInstance(FTInstancePtr instance)
+{
+    if( instance == NULL ) return;
+
+    if(instance->face->active_instance == instance)
+        instance->face->active_instance = NULL;
+    instance->refcount--;
+    if(instance->refcount <= 0) {
+        /* Instances using forceConstantSpacing never match again */
+        if(instance->ttcap.forceConstantSpacingEnd < 0 &&
+           instance->glyphBytes <= FT_RETIRED_MAX_BYTES / 4)
+            FreeTypeRetireInstance(instance);
+        else
+            FreeTypeDestroyInstance(instance);
     }
 }
 
@@ -670,9 +751,11 @@ FreeTypeInstanceGetGlyph(unsigned idx, int flags, CharInfoPtr *g, FTInstancePtr
 
     if((*available)[segment][offset] == FT_AVAILABLE_RASTERISED) {
 	*g = &(*glyphs)[segment][offset];
+	glyphHits++;
 	return Successful;
     }
 
+    glyphMisses++;
     flags |= FT_GET_GLYPH_BOTH;
 
     xrc = FreeTypeRasteriseGlyph(idx, flags,
@@ -686,7 +769,15 @@ FreeTypeInstanceGetGlyph(unsigned idx, int flags, CharInfoPtr *g, FTInstancePtr
 				     (*available)[segment][offset] >= FT_AVAILABLE_METRICS);
     }
     if(xrc == Successful) {
+        xCharInfo *m = &(*glyphs)[segment][offset].metrics;
+        int wd = m->rightSideBearing - m->leftSideBearing;
+        int ht = m->ascent + m->descent;
+
         (*available)[segment][offset] = FT_AVAILABLE_RASTERISED;
+        /* same size as allocated by FreeTypeRasteriseGlyph */
+        instance->glyphBytes += MAX(ht, 1) *
+            (((MAX(wd, 1) + (instance->bmfmt.glyph<<3) - 1) >> 3) &
+             -instance->bmfmt.glyph);
 	/* return the glyph */
         *g = &(*glyphs)[segment][offset];
     }
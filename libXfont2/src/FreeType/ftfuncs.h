@@ -137,7 +137,9 @@ typedef struct _FTInstance {
     int **available;
     struct TTCapInfo ttcap;
     int refcount;
+    unsigned long glyphBytes;   /* size of the rasterised bitmaps */
     struct _FTInstance *next;   /* link to next instance */
+    struct _FTInstance *retiredNext; /* link in the retired list */
 } FTInstanceRec, *FTInstancePtr;
 
 /* A font is an instance with coding information; fonts are in
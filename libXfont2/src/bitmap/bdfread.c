@@ -847,6 +847,8 @@ bdfReadFont(FontPtr pFont, FontFilePtr file,
     bitmapFont->bitmaps = 0;
     bitmapFont->encoding = 0;
     bitmapFont->pDefault = NULL;
+    bitmapFont->mapping = NULL;
+    bitmapFont->mappingSize = 0;
 
     bitmapFont->bitmapExtra = calloc(1, sizeof(BitmapExtraRec));
     if (!bitmapFont->bitmapExtra) {
@@ -858,6 +858,8 @@ ScaleFont(FontPtr opf,            /* originating font */
     bitmapFont->bitmaps = 0;
     bitmapFont->encoding = 0;
     bitmapFont->bitmapExtra = 0;
+    bitmapFont->mapping = 0;
+    bitmapFont->mappingSize = 0;
     bitmapFont->pDefault = 0;
     bitmapFont->metrics = malloc(nchars * sizeof(CharInfoRec));
     if (!bitmapFont->metrics) {
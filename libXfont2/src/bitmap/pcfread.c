@@ -417,6 +417,9 @@ pcfReadFont(FontPtr pFont, FontFilePtr file,
     CARD32      bitmapSizes[GLYPHPADOPTIONS];
     CARD32     *offsets = 0;
     Bool	hasBDFAccelerators;
+    Bool	needSwap;
+    void       *mapping = NULL;
+    size_t      mappingSize = 0;
 
     pFont->info.nprops = 0;
     pFont->info.props = 0;
@@ -500,22 +503,40 @@ pcfReadFont(FontPtr pFont, FontFilePtr file,
     }
 
     sizebitmaps = bitmapSizes[PCF_GLYPH_PAD_INDEX(format)];
-    /* guard against completely empty font */
-    bitmaps = malloc(sizebitmaps ? sizebitmaps : 1);
-    if (!bitmaps) {
-      pcfError("pcfReadFont(): Couldn't allocate bitmaps (%d)\n", sizebitmaps ? sizebitmaps : 1);
-	goto Bail;
+    needSwap = (PCF_BYTE_ORDER(format) == PCF_BIT_ORDER(format)) != (bit == byte)
+	&& (bit == byte ? PCF_SCAN_UNIT(format) : scan) != 1;
+
+    /*
+     * If the glyphs in the file are already laid out the way the server
+     * wants them, use them straight from a read-only mapping of the file
+     * instead of reading them into private memory, so that every server
+     * using the font shares a single copy.
+     */
+    if (sizebitmaps > 0 && (position & 3) == 0 &&
+	PCF_BIT_ORDER(format) == bit && !needSwap &&
+	PCF_GLYPH_PAD(format) == glyph &&
+	(mapping = FontFileMap(file, &mappingSize)) != NULL) {
+	if (position + (size_t) sizebitmaps > mappingSize ||
+	    !FontFileSkip(file, sizebitmaps))
+	    goto Bail;
+	bitmaps = (char *) mapping + position;
+	position += sizebitmaps;
+    } else {
+	/* guard against completely empty font */
+	bitmaps = malloc(sizebitmaps ? sizebitmaps : 1);
+	if (!bitmaps) {
+	  pcfError("pcfReadFont(): Couldn't allocate bitmaps (%d)\n", sizebitmaps ? sizebitmaps : 1);
+	    goto Bail;
+	}
+	FontFileRead(file, bitmaps, sizebitmaps);
+	if (IS_EOF(file)) goto Bail;
+	position += sizebitmaps;
     }
-    FontFileRead(file, bitmaps, sizebitmaps);
-    if (IS_EOF(file)) goto Bail;
-    position += sizebitmaps;
 
     if (PCF_BIT_ORDER(format) != bit)
 	BitOrderInvert((unsigned char *)bitmaps, sizebitmaps);
-    if ((PCF_BYTE_ORDER(format) == PCF_BIT_ORDER(format)) != (bit == byte)) {
+    if (needSwap) {
 	switch (bit == byte ? PCF_SCAN_UNIT(format) : scan) {
-	case 1:
-	    break;
 	case 2:
 	    TwoByteSwap((unsigned char *)bitmaps, sizebitmaps);
 	    break;
@@ -653,6 +674,8 @@ pcfReadFont(FontPtr pFont, FontFilePtr file,
     bitmapFont->metrics = metrics;
     bitmapFont->ink_metrics = ink_metrics;
     bitmapFont->bitmaps = bitmaps;
+    bitmapFont->mapping = mapping;
+    bitmapFont->mappingSize = mappingSize;
     bitmapFont->encoding = encoding;
     bitmapFont->pDefault = (CharInfoPtr) 0;
     if (pFont->info.defaultCh != (unsigned short) NO_SUCH_CHAR) {
@@ -689,7 +712,10 @@ Bail:
             free(encoding[i]);
     }
     free(encoding);
-    free(bitmaps);
+    if (mapping)
+	FontFileUnmap(mapping, mappingSize);
+    else
+	free(bitmaps);
     free(metrics);
     free(pFont->info.props);
     pFont->info.nprops = 0;
@@ -790,7 +816,10 @@ pcfUnloadFont(FontPtr pFont)
             free(bitmapFont->encoding[i]);
     }
     free(bitmapFont->encoding);
-    free(bitmapFont->bitmaps);
+    if (bitmapFont->mapping)
+	FontFileUnmap(bitmapFont->mapping, bitmapFont->mappingSize);
+    else
+	free(bitmapFont->bitmaps);
     free(bitmapFont->metrics);
     free(pFont->info.isStringProp);
     free(pFont->info.props);
@@ -288,6 +288,8 @@ snfReadFont(FontPtr pFont, FontFilePtr file,
     bitmapFont->bitmaps = bitmaps;
     bitmapFont->pDefault = NULL;
     bitmapFont->bitmapExtra = NULL;
+    bitmapFont->mapping = NULL;
+    bitmapFont->mappingSize = 0;
     pFont->info.props = (FontPropPtr) (fontspace + props_off);
     pFont->info.isStringProp = (char *) (fontspace + isStringProp_off);
     if (fi.inkMetrics)
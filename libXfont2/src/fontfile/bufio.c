@@ -120,6 +120,18 @@ BufFileRawClose (BufFilePtr f, int doClose)
     return 1;
 }
 
+/*
+ * Return the file descriptor behind a BufFile reading straight from a file,
+ * or -1 if f is a decompressing (or writing) stream.
+ */
+int
+BufFileRawFd (BufFilePtr f)
+{
+    if (f->input != BufFileRawFill)
+	return -1;
+    return FileDes (f);
+}
+
 BufFilePtr
 BufFileOpenRead (int fd)
 {
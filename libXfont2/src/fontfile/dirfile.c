@@ -40,19 +40,105 @@ in this Software without prior written authorization from The Open Group.
 #include "libxfontint.h"
 #include <X11/fonts/fntfilst.h>
 #include <stdio.h>
+#include <ctype.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <limits.h>
 
+/*
+ * fonts.dir and fonts.alias are read into memory in one go and parsed
+ * from there; going through stdio a character (or a scanf conversion)
+ * at a time is what used to dominate start-up with large font paths.
+ */
+typedef struct _DirFileBuf {
+    char	*data;
+    char	*ptr;
+    char	*end;
+} DirFileBufRec, *DirFileBufPtr;
+
 static Bool AddFileNameAliases ( FontDirectoryPtr dir );
 static int ReadFontAlias ( char *directory, Bool isFile,
 			   FontDirectoryPtr *pdir );
-static int lexAlias ( FILE *file, char **lexToken );
-static int lexc ( FILE *file );
+static int lexAlias ( DirFileBufPtr buf, char **lexToken );
+static int lexc ( DirFileBufPtr buf );
+
+/*
+ * Slurp an already opened file.  The size from stat is only a hint;
+ * text mode translation may shrink the contents and a concurrent
+ * writer may grow them.  A read error ends the data early, as EOF
+ * from getc/fscanf used to; only running out of memory fails.
+ */
+static Bool
+ReadDirFile (FILE *file, off_t hint, DirFileBufPtr buf)
+{
+    size_t	size, len, n;
+    char	*data, *ndata;
+
+    size = (hint > 0 && hint < INT_MAX) ? (size_t) hint + 1 : 4096;
+    data = malloc(size);
+    if (!data)
+	return FALSE;
+    len = 0;
+    for (;;) {
+	n = fread(data + len, 1, size - len - 1, file);
+	len += n;
+	if (len < size - 1)
+	    break;
+	if (size >= (INT_MAX >> 1)) {
+	    free(data);
+	    return FALSE;
+	}
+	ndata = realloc(data, size << 1);
+	if (!ndata) {
+	    free(data);
+	    return FALSE;
+	}
+	data = ndata;
+	size <<= 1;
+    }
+    data[len] = '\0';
+    buf->data = buf->ptr = data;
+    buf->end = data + len;
+    return TRUE;
+}
+
+static void
+SkipDirFileSpace (DirFileBufPtr buf)
+{
+    while (buf->ptr < buf->end && isspace((unsigned char) *buf->ptr))
+	buf->ptr++;
+}
 
-#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+/*
+ * Parse one "file-name font-name" line of fonts.dir with the same
+ * rules as the scanf format "%<n>s %<n>[^\n]\n" this used to be read
+ * with; returns the number of fields converted, or EOF.
+ */
+static int
+ParseDirEntry (DirFileBufPtr buf, char *file_name, char *font_name)
+{
+    int		len;
+
+    SkipDirFileSpace (buf);
+    if (buf->ptr == buf->end)
+	return EOF;
+    for (len = 0; len < MAXFONTFILENAMELEN - 1 && buf->ptr < buf->end &&
+		  !isspace((unsigned char) *buf->ptr); len++)
+	file_name[len] = *buf->ptr++;
+    file_name[len] = '\0';
+
+    SkipDirFileSpace (buf);
+    if (buf->ptr == buf->end)
+	return 1;
+    for (len = 0; len < MAXFONTNAMELEN - 1 && buf->ptr < buf->end &&
+		  *buf->ptr != '\n'; len++)
+	font_name[len] = *buf->ptr++;
+    font_name[len] = '\0';
+    SkipDirFileSpace (buf);
+    return 2;
+}
 
 int
 FontFileReadDirectory (const char *directory, FontDirectoryPtr *pdir)
@@ -67,8 +153,9 @@ FontFileReadDirectory (const char *directory, FontDirectoryPtr *pdir)
                 count,
                 num_fonts,
                 status;
+    long	nfonts;
     struct stat	statb;
-    static char format[24] = "";
+    DirFileBufRec buf;
 #if defined(WIN32)
     int i;
 #endif
@@ -112,22 +199,27 @@ FontFileReadDirectory (const char *directory, FontDirectoryPtr *pdir)
             fclose(file);
 	    return BadFontPath;
         }
-	count = fscanf(file, "%d\n", &num_fonts);
-	if ((count == EOF) || (count != 1)) {
+	if (!ReadDirFile (file, statb.st_size, &buf)) {
 	    fclose(file);
 	    return BadFontPath;
 	}
+	fclose(file);
+	nfonts = strtol(buf.ptr, &ptr, 10);
+	if (ptr == buf.ptr || nfonts < 0 || nfonts > INT_MAX) {
+	    free(buf.data);
+	    return BadFontPath;
+	}
+	num_fonts = nfonts;
+	buf.ptr = ptr;
+	SkipDirFileSpace (&buf);
 	dir = FontFileMakeDir(directory, num_fonts);
 	if (dir == NULL) {
-	    fclose(file);
+	    free(buf.data);
 	    return BadFontPath;
 	}
 	dir->dir_mtime = statb.st_mtime;
-	if (format[0] == '\0')
-	    sprintf(format, "%%%ds %%%d[^\n]\n",
-		MAXFONTFILENAMELEN-1, MAXFONTNAMELEN-1);
 
-	while ((count = fscanf(file, format, file_name, font_name)) != EOF) {
+	while ((count = ParseDirEntry(&buf, file_name, font_name)) != EOF) {
 #if defined(WIN32)
 	    /* strip any existing trailing CR */
 	    for (i=0; i<strlen(font_name); i++) {
@@ -136,7 +228,7 @@ FontFileReadDirectory (const char *directory, FontDirectoryPtr *pdir)
 #endif
 	    if (count != 2) {
 		FontFileFreeDir (dir);
-		fclose(file);
+		free(buf.data);
 		return BadFontPath;
 	    }
 
@@ -147,7 +239,7 @@ FontFileReadDirectory (const char *directory, FontDirectoryPtr *pdir)
 	     */
 	    FontFileAddFontFile (dir, font_name, file_name);
 	}
-	fclose(file);
+	free(buf.data);
 
     } else if (errno != ENOENT) {
 	return BadFontPath;
@@ -278,6 +370,7 @@ ReadFontAlias(char *directory, Bool isFile, FontDirectoryPtr *pdir)
     char		*lexToken;
     int			status = Successful;
     struct stat		statb;
+    DirFileBufRec	buf;
 
     if (strlen(directory) >= sizeof(alias_file))
 	return BadFontPath;
@@ -318,14 +411,20 @@ ReadFontAlias(char *directory, Bool isFile, FontDirectoryPtr *pdir)
 	fclose (file);
 	return BadFontPath;
     }
+    if (!ReadDirFile (file, statb.st_size, &buf))
+    {
+	fclose (file);
+	return AllocError;
+    }
+    fclose (file);
     dir->alias_mtime = statb.st_mtime;
     while (status == Successful) {
-	token = lexAlias(file, &lexToken);
+	token = lexAlias(&buf, &lexToken);
 	switch (token) {
 	case NEWLINE:
 	    break;
 	case DONE:
-	    fclose(file);
+	    free(buf.data);
 	    return Successful;
 	case EALLOC:
 	    status = AllocError;
@@ -336,7 +435,7 @@ ReadFontAlias(char *directory, Bool isFile, FontDirectoryPtr *pdir)
 		break;
 	    }
 	    strcpy(alias, lexToken);
-	    token = lexAlias(file, &lexToken);
+	    token = lexAlias(&buf, &lexToken);
 	    switch (token) {
 	    case NEWLINE:
 		if (strcmp(alias, "FILE_NAMES_ALIASES"))
@@ -363,7 +462,7 @@ ReadFontAlias(char *directory, Bool isFile, FontDirectoryPtr *pdir)
 	    }
 	}
     }
-    fclose(file);
+    free(buf.data);
     return status;
 }
 
@@ -377,7 +476,7 @@ ReadFontAlias(char *directory, Bool isFile, FontDirectoryPtr *pdir)
 static int  charClass;
 
 static int
-lexAlias(FILE *file, char **lexToken)
+lexAlias(DirFileBufPtr buf, char **lexToken)
 {
     int         c;
     char       *t;
@@ -408,7 +507,7 @@ lexAlias(FILE *file, char **lexToken)
 	    tokenSize = nsize;
 	    t = tokenBuf + count;
 	}
-	c = lexc(file);
+	c = lexc(buf);
 	switch (charClass) {
 	case QUOTE:
 	    switch (state) {
@@ -459,7 +558,8 @@ lexAlias(FILE *file, char **lexToken)
 	    default:
 		*t = '\0';
 		*lexToken = tokenBuf;
-		ungetc(c, file);
+		if (charClass == NL)
+		    buf->ptr--;
 		return NAME;
 	    }
 	    break;
@@ -480,21 +580,23 @@ lexAlias(FILE *file, char **lexToken)
 }
 
 static int
-lexc(FILE *file)
+lexc(DirFileBufPtr buf)
 {
     int         c;
 
-    c = getc(file);
-    switch (c) {
-    case EOF:
+    if (buf->ptr == buf->end) {
 	charClass = END;
-	break;
+	return EOF;
+    }
+    c = (unsigned char) *buf->ptr++;
+    switch (c) {
     case '\\':
-	c = getc(file);
-	if (c == EOF)
+	if (buf->ptr == buf->end) {
 	    charClass = END;
-	else
-	    charClass = NORMAL;
+	    return EOF;
+	}
+	c = (unsigned char) *buf->ptr++;
+	charClass = NORMAL;
 	break;
     case '"':
 	charClass = QUOTE;
@@ -34,6 +34,13 @@ in this Software without prior written authorization from The Open Group.
 #include "libxfontint.h"
 #include <X11/fonts/fntfilio.h>
 #include <X11/Xos.h>
+#include <sys/stat.h>
+#ifdef WIN32
+#include <X11/Xwindows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
 #ifndef O_BINARY
 #define O_BINARY O_RDONLY
 #endif
@@ -96,3 +103,51 @@ FontFileClose (FontFilePtr f)
     return BufFileClose ((BufFilePtr) f, TRUE);
 }
 
+/*
+ * Map the whole file behind an uncompressed FontFile read-only, so that font
+ * data can be used in place and is shared with every other process using
+ * the same file.  Returns NULL (and the caller should read the data the usual
+ * way) for compressed files or if the file can't be mapped.  The mapping
+ * stays valid after the FontFile is closed.
+ */
+void *
+FontFileMap (FontFilePtr f, size_t *sizep)
+{
+    int		fd;
+    struct stat	st;
+    void	*addr;
+
+    fd = BufFileRawFd ((BufFilePtr) f);
+    if (fd < 0 || fstat (fd, &st) < 0 || st.st_size <= 0)
+	return NULL;
+#ifdef WIN32
+    {
+	HANDLE	mapping;
+
+	mapping = CreateFileMapping ((HANDLE) _get_osfhandle (fd), NULL,
+				     PAGE_READONLY, 0, 0, NULL);
+	if (!mapping)
+	    return NULL;
+	addr = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle (mapping);
+	if (!addr)
+	    return NULL;
+    }
+#else
+    addr = mmap (NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+	return NULL;
+#endif
+    *sizep = st.st_size;
+    return addr;
+}
+
+void
+FontFileUnmap (void *addr, size_t size)
+{
+#ifdef WIN32
+    UnmapViewOfFile (addr);
+#else
+    munmap (addr, size);
+#endif
+}
@@ -41,6 +41,8 @@ in this Software without prior written authorization from The Open Group.
 #define INT32_MAX 0x7fffffff
 #endif
 
+static void FontFileFreeIndex (FontTablePtr table);
+
 Bool
 FontFileInitTable (FontTablePtr table, int size)
 {
@@ -57,6 +59,8 @@ FontFileInitTable (FontTablePtr table, int size)
     table->used = 0;
     table->size = size;
     table->sorted = FALSE;
+    table->index = NULL;
+    table->index_failed = FALSE;
     return TRUE;
 }
 
@@ -100,6 +104,7 @@ FontFileFreeTable (FontTablePtr table)
     for (i = 0; i < table->used; i++)
 	FontFileFreeEntry (&table->entries[i]);
     free (table->entries);
+    FontFileFreeIndex (table);
 }
 
 FontDirectoryPtr
@@ -178,12 +183,13 @@ FontFileAddEntry(FontTablePtr table, FontEntryPtr prototype)
     if (table->sorted)
 	return (FontEntryPtr) 0;    /* "cannot" happen */
     if (table->used == table->size) {
-	if (table->size >= ((INT32_MAX / sizeof(FontEntryRec)) - 100))
+	if (table->size >= ((INT32_MAX / sizeof(FontEntryRec)) / 2 - 100))
 	    /* If we've read so many entries we're going to ask for 2gb
 	       or more of memory, something is so wrong with this font
 	       directory that we should just give up before we overflow. */
 	    return NULL;
-	newsize = table->size + 100;
+	/* grow geometrically, big directories otherwise go quadratic */
+	newsize = table->size ? table->size * 2 : 100;
 	entry = realloc(table->entries, newsize * sizeof(FontEntryRec));
 	if (!entry)
 	    return (FontEntryPtr)0;
@@ -360,6 +366,224 @@ SetupWildMatch(FontTablePtr table, FontNamePtr pat,
     }
 }
 
+/*
+ * SetupWildMatch can only narrow the range on a literal prefix, so the
+ * usual "-*-family-...-registry-encoding" patterns end up running
+ * PatternMatch over the whole table.  Sorted tables of at least
+ * INDEX_MIN_ENTRIES names therefore get inverted lists on a few selective
+ * XLFD fields: a pattern with all 14 dashes and a literal value in one of
+ * those fields only has to be matched against the names listed under that
+ * value.  Smaller tables are cheaper to scan than to index.  With equal dash
+ * counts pattern and name fields line up one to one; names with fewer
+ * dashes can never match and names with more might through a '*', so
+ * the latter are always checked as well.
+ */
+
+#define XLFD_NDASHES		14
+#define INDEX_MIN_ENTRIES	64
+
+static const int indexFields[] = {
+    1,		/* FOUNDRY */
+    2,		/* FAMILY_NAME */
+    13,		/* CHARSET_REGISTRY */
+};
+#define NUM_INDEX_FIELDS    (sizeof indexFields / sizeof indexFields[0])
+
+typedef struct _FontFieldIndex {
+    unsigned	mask;			    /* number of buckets - 1 */
+    int		*first[NUM_INDEX_FIELDS];   /* bucket -> offset in list */
+    int		*list[NUM_INDEX_FIELDS];    /* entries by bucket, ascending */
+    int		*extra;			    /* entries with extra dashes */
+    int		nextra;
+} FontFieldIndexRec, *FontFieldIndexPtr;
+
+typedef struct _FontIndexCursor {
+    Bool	all;
+    const int	*a, *aend;
+    const int	*b, *bend;
+} FontIndexCursorRec, *FontIndexCursorPtr;
+
+static Bool
+FontFieldFind(const char *name, int field, const char **start, int *len)
+{
+    const char	*end;
+
+    while (field--) {
+	name = strchr(name, XK_minus);
+	if (!name)
+	    return FALSE;
+	name++;
+    }
+    end = strchr(name, XK_minus);
+    *start = name;
+    *len = end ? end - name : strlen(name);
+    return TRUE;
+}
+
+static unsigned
+FontFieldHash(const char *s, int len)
+{
+    unsigned	h = 2166136261u;
+
+    while (len--)
+	h = (h ^ (unsigned char) *s++) * 16777619u;
+    return h;
+}
+
+static void
+FontFileFreeIndex (FontTablePtr table)
+{
+    FontFieldIndexPtr	idx = table->index;
+    unsigned		f;
+
+    if (!idx)
+	return;
+    for (f = 0; f < NUM_INDEX_FIELDS; f++) {
+	free (idx->first[f]);
+	free (idx->list[f]);
+    }
+    free (idx->extra);
+    free (idx);
+    table->index = NULL;
+}
+
+static FontFieldIndexPtr
+FontFileBuildIndex (FontTablePtr table)
+{
+    FontFieldIndexPtr	idx;
+    FontEntryPtr	entry;
+    const char		*field;
+    int			*fill;
+    int			i, len, nxlfd = 0, nextra = 0;
+    unsigned		f, b, nbuckets;
+
+    for (i = 0; i < table->used; i++) {
+	if (table->entries[i].name.ndashes == XLFD_NDASHES)
+	    nxlfd++;
+	else if (table->entries[i].name.ndashes > XLFD_NDASHES)
+	    nextra++;
+    }
+    for (nbuckets = 16; nbuckets < nxlfd; nbuckets <<= 1)
+	;
+
+    idx = calloc (1, sizeof (FontFieldIndexRec));
+    fill = malloc (nbuckets * sizeof (int));
+    if (!idx || !fill)
+	goto bail;
+    table->index = idx;
+    idx->mask = nbuckets - 1;
+    idx->extra = malloc ((nextra ? nextra : 1) * sizeof (int));
+    if (!idx->extra)
+	goto bail;
+    for (i = 0, entry = table->entries; i < table->used; i++, entry++)
+	if (entry->name.ndashes > XLFD_NDASHES)
+	    idx->extra[idx->nextra++] = i;
+
+    for (f = 0; f < NUM_INDEX_FIELDS; f++) {
+	idx->first[f] = calloc (nbuckets + 1, sizeof (int));
+	idx->list[f] = malloc ((nxlfd ? nxlfd : 1) * sizeof (int));
+	if (!idx->first[f] || !idx->list[f])
+	    goto bail;
+	for (i = 0, entry = table->entries; i < table->used; i++, entry++) {
+	    if (entry->name.ndashes != XLFD_NDASHES)
+		continue;
+	    FontFieldFind (entry->name.name, indexFields[f], &field, &len);
+	    idx->first[f][(FontFieldHash (field, len) & idx->mask) + 1]++;
+	}
+	for (b = 0; b < nbuckets; b++) {
+	    idx->first[f][b + 1] += idx->first[f][b];
+	    fill[b] = idx->first[f][b];
+	}
+	for (i = 0, entry = table->entries; i < table->used; i++, entry++) {
+	    if (entry->name.ndashes != XLFD_NDASHES)
+		continue;
+	    FontFieldFind (entry->name.name, indexFields[f], &field, &len);
+	    idx->list[f][fill[FontFieldHash (field, len) & idx->mask]++] = i;
+	}
+    }
+    free (fill);
+    return idx;
+
+  bail:
+    free (fill);
+    if (table->index)
+	FontFileFreeIndex (table);
+    else
+	free (idx);
+    return NULL;
+}
+
+/*
+ * Set up a cursor over the entries worth matching against pat.  Without
+ * a usable idx that is every entry; FontFileIndexNext then simply
+ * counts up.
+ */
+static void
+FontFileIndexLookup (FontTablePtr table, FontNamePtr pat, int private,
+		     FontIndexCursorPtr cursor)
+{
+    FontFieldIndexPtr	idx;
+    const char		*field;
+    int			len, n, best = -1, bestlen = 0;
+    unsigned		f, b, bestb = 0;
+
+    cursor->all = TRUE;
+    if (private < 0 || pat->ndashes != XLFD_NDASHES ||
+	!table->sorted || table->used < INDEX_MIN_ENTRIES)
+	return;
+    idx = table->index;
+    if (!idx) {
+	/* Don't retry a failed build on every lookup, just scan */
+	if (table->index_failed)
+	    return;
+	if (!(idx = FontFileBuildIndex (table))) {
+	    table->index_failed = TRUE;
+	    return;
+	}
+    }
+    for (f = 0; f < NUM_INDEX_FIELDS; f++) {
+	if (!FontFieldFind (pat->name, indexFields[f], &field, &len))
+	    return;
+	for (n = 0; n < len; n++)
+	    if (isWild(field[n]))
+		break;
+	if (n < len)
+	    continue;
+	b = FontFieldHash (field, len) & idx->mask;
+	n = idx->first[f][b + 1] - idx->first[f][b];
+	if (best < 0 || n < bestlen) {
+	    best = f;
+	    bestb = b;
+	    bestlen = n;
+	}
+    }
+    if (best < 0)
+	return;
+    cursor->all = FALSE;
+    cursor->a = idx->list[best] + idx->first[best][bestb];
+    cursor->aend = cursor->a + bestlen;
+    cursor->b = idx->extra;
+    cursor->bend = idx->extra + idx->nextra;
+}
+
+/* Next candidate entry at or after i, or INT32_MAX once exhausted */
+static int
+FontFileIndexNext (FontIndexCursorPtr cursor, int i)
+{
+    if (cursor->all)
+	return i;
+    while (cursor->a < cursor->aend && *cursor->a < i)
+	cursor->a++;
+    while (cursor->b < cursor->bend && *cursor->b < i)
+	cursor->b++;
+    if (cursor->a < cursor->aend &&
+	(cursor->b == cursor->bend || *cursor->a < *cursor->b))
+	return *cursor->a;
+    if (cursor->b < cursor->bend)
+	return *cursor->b;
+    return INT32_MAX;
+}
+
 static int
 PatternMatch(char *pat, int patdashes, char *string, int stringdashes)
 {
@@ -451,12 +675,15 @@ FontFileFindNameInScalableDir(FontTablePtr table, FontNamePtr pat,
                 res,
                 private;
     FontNamePtr	name;
+    FontIndexCursorRec cursor;
 
     if (!table->entries)
 	return NULL;
     if ((i = SetupWildMatch(table, pat, &start, &stop, &private)) >= 0)
 	return &table->entries[i];
-    for (i = start; i < stop; i++) {
+    FontFileIndexLookup(table, pat, private, &cursor);
+    for (i = FontFileIndexNext(&cursor, start); i < stop;
+	 i = FontFileIndexNext(&cursor, i + 1)) {
 	name = &table->entries[i].name;
 	res = PatternMatch(pat->name, private, name->name, name->ndashes);
 	if (res > 0)
@@ -507,6 +734,7 @@ FontFileFindNamesInScalableDir(FontTablePtr table, FontNamePtr pat, int max,
     int		    ret = Successful;
     FontEntryPtr    fname;
     FontNamePtr	    name;
+    FontIndexCursorRec cursor;
 
     if (max <= 0)
 	return Successful;
@@ -521,7 +749,10 @@ FontFileFindNamesInScalableDir(FontTablePtr table, FontNamePtr pat, int max,
 	start = i;
 	stop = i + 1;
     }
-    for (i = start, fname = &table->entries[start]; i < stop; i++, fname++) {
+    FontFileIndexLookup(table, pat, private, &cursor);
+    for (i = FontFileIndexNext(&cursor, start); i < stop;
+	 i = FontFileIndexNext(&cursor, i + 1)) {
+	fname = &table->entries[i];
 	res = PatternMatch(pat->name, private, fname->name.name, fname->name.ndashes);
 	if (res > 0) {
 	    if (vals)
@@ -601,6 +832,8 @@ FontFileMatchName(char *name, int length, FontNamePtr pat)
     table.used = 1;
     table.size = 1;
     table.sorted = TRUE;
+    table.index = NULL;
+    table.index_failed = FALSE;
     table.entries = entries;
     entries[0].name.name = name;
     entries[0].name.length = length;
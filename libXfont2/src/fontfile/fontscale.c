@@ -34,6 +34,7 @@ in this Software without prior written authorization from The Open Group.
 #include "libxfontint.h"
 #include    <X11/fonts/fntfilst.h>
 #include <math.h>
+#include <stdint.h>
 
 Bool
 FontFileAddScaledInstance (FontEntryPtr entry, FontScalablePtr vals,
@@ -64,6 +65,15 @@ FontFileAddScaledInstance (FontEntryPtr entry, FontScalablePtr vals,
     return TRUE;
 }
 
+static int
+FontFileCompareNamePointers (const void *a, const void *b)
+{
+    uintptr_t	a_name = (uintptr_t) (*(FontEntryPtr const *) a)->name.name;
+    uintptr_t	b_name = (uintptr_t) (*(FontEntryPtr const *) b)->name.name;
+
+    return a_name < b_name ? -1 : a_name > b_name;
+}
+
 /* Must call this after the directory is sorted */
 
 void
@@ -76,9 +86,47 @@ FontFileSwitchStringsToBitmapPointers (FontDirectoryPtr dir)
     FontEntryPtr	    nonScalable;
     FontScaledPtr	    scaled;
     FontScalableExtraPtr    extra;
+    FontEntryPtr	    *byName, key, *found;
+    FontEntryRec	    keyRec;
 
     scalable = dir->scalable.entries;
     nonScalable = dir->nonScalable.entries;
+
+    /*
+     * Every bitmap instance of every scalable entry used to be looked up
+     * with a scan of the whole nonScalable table, which made directories
+     * with thousands of bitmap fonts quadratic to load.  Look the name
+     * pointers up in a table sorted by address instead, and only fall
+     * back to the scan if that cannot be allocated.
+     */
+    byName = NULL;
+    if (dir->scalable.used && dir->nonScalable.used)
+	byName = malloc (dir->nonScalable.used * sizeof (FontEntryPtr));
+    if (byName)
+    {
+	for (b = 0; b < dir->nonScalable.used; b++)
+	    byName[b] = &nonScalable[b];
+	qsort (byName, dir->nonScalable.used, sizeof (FontEntryPtr),
+	       FontFileCompareNamePointers);
+	key = &keyRec;
+	for (s = 0; s < dir->scalable.used; s++)
+	{
+	    extra = scalable[s].u.scalable.extra;
+	    scaled = extra->scaled;
+	    for (i = 0; i < extra->numScaled; i++)
+	    {
+		keyRec.name.name = (char *) scaled[i].bitmap;
+		found = bsearch (&key, byName, dir->nonScalable.used,
+				 sizeof (FontEntryPtr),
+				 FontFileCompareNamePointers);
+		if (found)
+		    scaled[i].bitmap = *found;
+	    }
+	}
+	free (byName);
+	return;
+    }
+
     for (s = 0; s < dir->scalable.used; s++)
     {
 	extra = scalable[s].u.scalable.extra;
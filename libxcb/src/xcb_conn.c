@@ -543,11 +543,26 @@ int _xcb_conn_wait(xcb_connection_t *c, pthread_cond_t *cond, struct iovec **vec
             ret = ret && _xcb_in_read(c);
 
 #if USE_POLL
-        if((fd.revents & POLLOUT) != 0)
+        if(ret && (fd.revents & POLLOUT) != 0)
 #else
-        if(FD_ISSET(c->fd, &wfds))
+        if(ret && FD_ISSET(c->fd, &wfds))
 #endif
-            ret = ret && write_vec(c, vector, count);
+        {
+            /* c->out.writing keeps other writers and request submitters
+             * waiting, so a plain socket write doesn't need the iolock;
+             * let threads polling for replies and events run meanwhile.
+             * File descriptors are still passed with the lock held, see
+             * send_fds(). */
+            int unlocked = 1;
+#if HAVE_SENDMSG
+            unlocked = !c->out.out_fd.nfd;
+#endif
+            if(unlocked)
+                pthread_mutex_unlock(&c->iolock);
+            ret = write_vec(c, vector, count);
+            if(unlocked)
+                pthread_mutex_lock(&c->iolock);
+        }
     }
 
     if(count)
@@ -842,6 +842,31 @@ swap_image(uint8_t *	     src,
 	   int		     bitswap,
 	   int               nibbleswap)
 {
+  /* When the scanlines line up, swap a 32-bit word at a time; byteswap
+     is one of 0..3, so every swap stays within one word. */
+  if (src_stride == dst_stride && (src_stride & 3) == 0) {
+      uint32_t  n = src_stride * height;
+      uint32_t  i;
+
+      for (i = 0; i < n; i += 4) {
+	  uint32_t  v;
+
+	  memcpy(&v, src + i, 4);
+	  if (byteswap & 1)
+	      v = ((v >> 8) & 0x00ff00ff) | ((v & 0x00ff00ff) << 8);
+	  if (byteswap & 2)
+	      v = (v >> 16) | (v << 16);
+	  if (bitswap) {
+	      v = ((v >> 1) & 0x55555555) | ((v & 0x55555555) << 1);
+	      v = ((v >> 2) & 0x33333333) | ((v & 0x33333333) << 2);
+	      v = ((v >> 4) & 0x0f0f0f0f) | ((v & 0x0f0f0f0f) << 4);
+	  }
+	  if (nibbleswap)
+	      v = ((v >> 4) & 0x0f0f0f0f) | ((v & 0x0f0f0f0f) << 4);
+	  memcpy(dst + i, &v, 4);
+      }
+      return;
+  }
   while (height--) {
       uint32_t    s;
 
@@ -916,6 +941,155 @@ conversion_byte_swap(xcb_image_t *src, xcb_image_t *dst)
     }
 }
 
+/* Z pixmaps of 8, 16, 24 and 32 bpp are converted a scanline at a
+   time: pixels are unpacked into a buffer of values and packed again
+   in the destination layout, with the same results as
+   xcb_image_get_pixel/xcb_image_put_pixel. */
+
+#define Z_CHUNK 256
+
+static int
+z_bulk_format(xcb_image_t *image)
+{
+  if (effective_format(image->format, image->bpp) != XCB_IMAGE_FORMAT_Z_PIXMAP)
+      return 0;
+  switch (image->bpp) {
+  case 8:
+  case 16:
+  case 24:
+  case 32:
+      return 1;
+  }
+  return 0;
+}
+
+
+static void
+unpack_z_pixels(const uint8_t *row, uint32_t *pixels, uint32_t n,
+		uint8_t bpp, xcb_image_order_t byte_order)
+{
+  uint32_t  i;
+  int       msb = byte_order == XCB_IMAGE_ORDER_MSB_FIRST;
+
+  switch (bpp) {
+  case 8:
+      for (i = 0; i < n; i++)
+	  pixels[i] = row[i];
+      break;
+  case 16:
+      if (msb)
+	  for (i = 0; i < n; i++, row += 2)
+	      pixels[i] = (row[0] << 8) | row[1];
+      else
+	  for (i = 0; i < n; i++, row += 2)
+	      pixels[i] = row[0] | (row[1] << 8);
+      break;
+  case 24:
+      if (msb)
+	  for (i = 0; i < n; i++, row += 3)
+	      pixels[i] = (row[0] << 16) | (row[1] << 8) | row[2];
+      else
+	  for (i = 0; i < n; i++, row += 3)
+	      pixels[i] = row[0] | (row[1] << 8) | (row[2] << 16);
+      break;
+  case 32:
+      if (msb)
+	  for (i = 0; i < n; i++, row += 4)
+	      pixels[i] = ((uint32_t) row[0] << 24) | (row[1] << 16) |
+			  (row[2] << 8) | row[3];
+      else
+	  for (i = 0; i < n; i++, row += 4)
+	      pixels[i] = row[0] | (row[1] << 8) | (row[2] << 16) |
+			  ((uint32_t) row[3] << 24);
+      break;
+  }
+}
+
+
+static void
+pack_z_pixels(uint8_t *row, const uint32_t *pixels, uint32_t n,
+	      uint8_t bpp, xcb_image_order_t byte_order)
+{
+  uint32_t  i;
+  int       msb = byte_order == XCB_IMAGE_ORDER_MSB_FIRST;
+
+  switch (bpp) {
+  case 8:
+      for (i = 0; i < n; i++)
+	  row[i] = pixels[i];
+      break;
+  case 16:
+      if (msb)
+	  for (i = 0; i < n; i++, row += 2) {
+	      row[0] = pixels[i] >> 8;
+	      row[1] = pixels[i];
+	  }
+      else
+	  for (i = 0; i < n; i++, row += 2) {
+	      row[0] = pixels[i];
+	      row[1] = pixels[i] >> 8;
+	  }
+      break;
+  case 24:
+      if (msb)
+	  for (i = 0; i < n; i++, row += 3) {
+	      row[0] = pixels[i] >> 16;
+	      row[1] = pixels[i] >> 8;
+	      row[2] = pixels[i];
+	  }
+      else
+	  for (i = 0; i < n; i++, row += 3) {
+	      row[0] = pixels[i];
+	      row[1] = pixels[i] >> 8;
+	      row[2] = pixels[i] >> 16;
+	  }
+      break;
+  case 32:
+      if (msb)
+	  for (i = 0; i < n; i++, row += 4) {
+	      row[0] = pixels[i] >> 24;
+	      row[1] = pixels[i] >> 16;
+	      row[2] = pixels[i] >> 8;
+	      row[3] = pixels[i];
+	  }
+      else
+	  for (i = 0; i < n; i++, row += 4) {
+	      row[0] = pixels[i];
+	      row[1] = pixels[i] >> 8;
+	      row[2] = pixels[i] >> 16;
+	      row[3] = pixels[i] >> 24;
+	  }
+      break;
+  }
+}
+
+
+static void
+convert_z_pixels(xcb_image_t *src, xcb_image_t *dst)
+{
+  uint32_t  pixels[Z_CHUNK];
+  uint32_t  src_bytes = src->bpp >> 3;
+  uint32_t  dst_bytes = dst->bpp >> 3;
+  uint32_t  x, y;
+
+  for (y = 0; y < src->height; y++) {
+      uint8_t *  srow = src->data + y * src->stride;
+      uint8_t *  drow = dst->data + y * dst->stride;
+
+      for (x = 0; x < src->width; x += Z_CHUNK) {
+	  uint32_t  n = src->width - x;
+
+	  if (n > Z_CHUNK)
+	      n = Z_CHUNK;
+	  unpack_z_pixels(srow + x * src_bytes, pixels, n,
+			  src->bpp, src->byte_order);
+	  pack_z_pixels(drow + x * dst_bytes, pixels, n,
+			dst->bpp, dst->byte_order);
+      }
+  }
+}
+
+
 xcb_image_t *
 xcb_image_convert (xcb_image_t *  src,
 		   xcb_image_t *  dst)
@@ -962,12 +1136,15 @@ xcb_image_convert (xcb_image_t *  src,
 		  height, byteswap, bitswap, nibbleswap);
     }
   }
+  else if (z_bulk_format(src) && z_bulk_format(dst))
+  {
+    convert_z_pixels(src, dst);
+  }
   else
   {
     uint32_t            x;
     uint32_t            y;
-    /* General case: Slow pixel copy. Should we optimize
-       Z24<->Z32 copies of either endianness? */
+    /* General case: Slow pixel copy. */
     for (y = 0; y < src->height; y++) {
 	for (x = 0; x < src->width; x++) {
 	    uint32_t  pixel = xcb_image_get_pixel(src, x, y);
@@ -1002,6 +1179,14 @@ xcb_image_subimage(xcb_image_t *  image,
 			      base, bytes, data);
     if (!result)
 	return 0;
+    if (z_bulk_format(image)) {
+	for (j = 0; j < height; j++)
+	    memcpy(result->data + j * result->stride,
+		   image->data + (y + j) * image->stride +
+		   x * (image->bpp >> 3),
+		   width * (image->bpp >> 3));
+	return result;
+    }
     /* XXX FIXME  For now, lose on performance. Sorry. */
     for (j = 0; j < height; j++) {
 	for (i = 0; i < width; i++) {
@@ -167,6 +167,28 @@ static int event_special(xcb_connection_t *c,
     return 0;
 }
 
+static struct event_list *alloc_event_list(xcb_connection_t *c)
+{
+    struct event_list *cur = c->in.free_events;
+    if(!cur)
+        return malloc(sizeof(struct event_list));
+    c->in.free_events = cur->next;
+    --c->in.free_events_len;
+    return cur;
+}
+
+static void free_event_list(xcb_connection_t *c, struct event_list *cur)
+{
+    if(c->in.free_events_len >= XCB_EVENT_LIST_CACHE)
+    {
+        free(cur);
+        return;
+    }
+    cur->next = c->in.free_events;
+    c->in.free_events = cur;
+    ++c->in.free_events_len;
+}
+
 static int read_packet(xcb_connection_t *c)
 {
     xcb_generic_reply_t genrep;
@@ -183,7 +205,7 @@ static int read_packet(xcb_connection_t *c)
         return 0;
 
     /* Get the response type, length, and sequence number. */
-    memcpy(&genrep, c->in.queue, sizeof(genrep));
+    memcpy(&genrep, c->in.queue + c->in.queue_start, sizeof(genrep));
 
     /* Compute 32-bit sequence number of this packet. */
     if((genrep.response_type & 0x7f) != XCB_KEYMAP_NOTIFY)
@@ -238,7 +260,7 @@ static int read_packet(xcb_connection_t *c)
     {
         if(pend && pend->workaround == WORKAROUND_GLX_GET_FB_CONFIGS_BUG)
         {
-            uint32_t *p = (uint32_t *) c->in.queue;
+            uint32_t *p = (uint32_t *) (c->in.queue + c->in.queue_start);
             genrep.length = p[2] * p[3] * 2;
         }
         length += genrep.length * 4;
@@ -322,7 +344,7 @@ static int read_packet(xcb_connection_t *c)
     }
 
     /* event, or unchecked error */
-    event = malloc(sizeof(struct event_list));
+    event = alloc_event_list(c);
     if(!event)
     {
         _xcb_conn_shutdown(c, XCB_CONN_CLOSED_MEM_INSUFFICIENT);
@@ -350,7 +372,7 @@ static xcb_generic_event_t *get_event(xcb_connection_t *c)
     c->in.events = cur->next;
     if(!cur->next)
         c->in.events_tail = &c->in.events;
-    free(cur);
+    free_event_list(c, cur);
     return ret;
 }
 
@@ -878,6 +900,7 @@ int _xcb_in_init(_xcb_in *in)
         return 0;
     in->reading = 0;
 
+    in->queue_start = 0;
     in->queue_len = 0;
 
     in->request_read = 0;
@@ -889,6 +912,8 @@ int _xcb_in_init(_xcb_in *in)
 
     in->current_reply_tail = &in->current_reply;
     in->events_tail = &in->events;
+    in->free_events = 0;
+    in->free_events_len = 0;
     in->pending_replies_tail = &in->pending_replies;
 
     return 1;
@@ -906,6 +931,12 @@ void _xcb_in_destroy(_xcb_in *in)
         free(e->event);
         free(e);
     }
+    while(in->free_events)
+    {
+        struct event_list *e = in->free_events;
+        in->free_events = e->next;
+        free(e);
+    }
     while(in->pending_replies)
     {
         pending_reply *pend = in->pending_replies;
@@ -964,8 +995,8 @@ int _xcb_in_read(xcb_connection_t *c)
 
 #if HAVE_SENDMSG
     struct iovec    iov = {
-        .iov_base = c->in.queue + c->in.queue_len,
-        .iov_len = sizeof(c->in.queue) - c->in.queue_len,
+        .iov_base = c->in.queue + c->in.queue_start + c->in.queue_len,
+        .iov_len = sizeof(c->in.queue) - c->in.queue_start - c->in.queue_len,
     };
     union {
         struct cmsghdr cmsghdr;
@@ -991,7 +1022,7 @@ int _xcb_in_read(xcb_connection_t *c)
         return 0;
     }
 #else
-    n = recv(c->fd, c->in.queue + c->in.queue_len, sizeof(c->in.queue) - c->in.queue_len, 0);
+    n = recv(c->fd, c->in.queue + c->in.queue_start + c->in.queue_len, sizeof(c->in.queue) - c->in.queue_start - c->in.queue_len, 0);
 #endif
     if(n > 0) {
 #if HAVE_SENDMSG
@@ -1011,6 +1042,14 @@ int _xcb_in_read(xcb_connection_t *c)
     }
     while(read_packet(c))
         /* empty */;
+    /* Packets are consumed from the front of the queue without moving
+     * the rest; move any partial packet down once, so that the next
+     * read gets all the free space. */
+    if(c->in.queue_start)
+    {
+        memmove(c->in.queue, c->in.queue + c->in.queue_start, c->in.queue_len);
+        c->in.queue_start = 0;
+    }
 #if HAVE_SENDMSG
     if (c->in.in_fd.nfd) {
         c->in.in_fd.nfd -= c->in.in_fd.ifd;
@@ -1048,9 +1087,9 @@ int _xcb_in_read_block(xcb_connection_t *c, void *buf, int len)
     if(len < done)
         done = len;
 
-    memcpy(buf, c->in.queue, done);
+    memcpy(buf, c->in.queue + c->in.queue_start, done);
     c->in.queue_len -= done;
-    memmove(c->in.queue, c->in.queue + done, c->in.queue_len);
+    c->in.queue_start = c->in.queue_len ? c->in.queue_start + done : 0;
 
     if(len > done)
     {
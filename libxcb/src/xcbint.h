@@ -125,11 +125,18 @@ int _xcb_out_flush_to(xcb_connection_t *c, uint64_t request);
 
 /* xcb_in.c */
 
+/* Large enough that a burst of events is parsed out of a single read. */
+#define XCB_IN_QUEUE_BUFFER_SIZE 16384
+
+/* Number of spare event list nodes kept for reuse. */
+#define XCB_EVENT_LIST_CACHE 64
+
 typedef struct _xcb_in {
     pthread_cond_t event_cond;
     int reading;
 
-    char queue[4096];
+    char queue[XCB_IN_QUEUE_BUFFER_SIZE];
+    int queue_start;
     int queue_len;
 
     uint64_t request_expected;
@@ -141,6 +148,8 @@ typedef struct _xcb_in {
     _xcb_map *replies;
     struct event_list *events;
     struct event_list **events_tail;
+    struct event_list *free_events;
+    int free_events_len;
     struct reader_list *readers;
     struct special_list *special_waiters;
 
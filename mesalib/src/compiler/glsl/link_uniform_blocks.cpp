@@ -468,9 +468,13 @@ link_uniform_blocks(void *mem_ctx,
 
    }
 
-   create_buffer_blocks(mem_ctx, ctx, prog, ubo_blocks, *num_ubo_blocks,
+   /* The blocks end up owned by the linked shader, so allocate them there
+    * rather than in the linker's arena context, where they would keep the
+    * arena chunks they were carved from alive.
+    */
+   create_buffer_blocks(shader, ctx, prog, ubo_blocks, *num_ubo_blocks,
                         block_hash, num_ubo_variables, true);
-   create_buffer_blocks(mem_ctx, ctx, prog, ssbo_blocks, *num_ssbo_blocks,
+   create_buffer_blocks(shader, ctx, prog, ssbo_blocks, *num_ssbo_blocks,
                         block_hash, num_ssbo_variables, false);
 
    _mesa_hash_table_destroy(block_hash, NULL);
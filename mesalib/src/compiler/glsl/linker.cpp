@@ -4578,7 +4578,10 @@ link_shaders(struct gl_context *ctx, struct gl_shader_program *prog)
       return;
 #endif
 
-   void *mem_ctx = ralloc_context(NULL); // temporary linker context
+   /* Temporary linker context.  Linking allocates huge numbers of small
+    * temporaries that all die with this context, so arena allocate them.
+    */
+   void *mem_ctx = ralloc_arena_context(NULL);
 
    prog->ARB_fragment_coord_conventions_enable = false;
 
@@ -4971,8 +4974,15 @@ done:
        */
       validate_ir_tree(prog->_LinkedShaders[i]->ir);
 
-      /* Retain any live IR, but trash the rest. */
-      reparent_ir(prog->_LinkedShaders[i]->ir, prog->_LinkedShaders[i]->ir);
+      /* Retain any live IR, but trash the rest.  The IR lives in the arena
+       * context, so copy it out rather than stealing it: a stolen node
+       * would keep its whole arena chunk, and every dead temporary in it,
+       * alive for as long as the program.
+       */
+      exec_list *ir = new(prog->_LinkedShaders[i]) exec_list;
+      clone_ir_list(prog->_LinkedShaders[i], ir, prog->_LinkedShaders[i]->ir);
+      ralloc_free(prog->_LinkedShaders[i]->ir);
+      prog->_LinkedShaders[i]->ir = ir;
 
       /* The symbol table in the linked shaders may contain references to
        * variables that were removed (e.g., unused uniforms).  Since it may
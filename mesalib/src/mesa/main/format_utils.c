@@ -288,6 +288,7 @@ _mesa_format_convert(void *void_dst, uint32_t dst_format, size_t dst_stride,
    enum mesa_array_format_datatype src_type = 0, dst_type = 0, common_type;
    bool normalized, dst_integer, src_integer, is_signed;
    int src_num_channels = 0, dst_num_channels = 0;
+   bool ubyte4_shuffle = false;
    uint8_t (*tmp_ubyte)[4];
    float (*tmp_float)[4];
    uint32_t (*tmp_uint)[4];
@@ -329,6 +330,11 @@ _mesa_format_convert(void *void_dst, uint32_t dst_format, size_t dst_stride,
            src_array_format == dst_array_format) ||
           src_format == dst_format) {
          int format_size = _mesa_get_format_bytes(src_format);
+         if (src_stride == dst_stride &&
+             src_stride == width * format_size) {
+            memcpy(dst, src, width * format_size * height);
+            return;
+         }
          for (row = 0; row < height; row++) {
             memcpy(dst, src, width * format_size);
             src += src_stride;
@@ -337,6 +343,23 @@ _mesa_format_convert(void *void_dst, uint32_t dst_format, size_t dst_stride,
          return;
       }
 
+      /* Conversions between 4x8-bit formats that only reorder components
+       * (e.g. BGRA framebuffers read back as GL_RGBA/GL_UNSIGNED_BYTE) are
+       * done by the array format path below, which is cheaper than going
+       * through the per-format unpack/pack functions.
+       */
+      ubyte4_shuffle = src_array_format && dst_array_format &&
+         _mesa_array_format_get_datatype(src_array_format) ==
+            MESA_ARRAY_FORMAT_TYPE_UBYTE &&
+         _mesa_array_format_get_datatype(dst_array_format) ==
+            MESA_ARRAY_FORMAT_TYPE_UBYTE &&
+         _mesa_array_format_get_num_channels(src_array_format) == 4 &&
+         _mesa_array_format_get_num_channels(dst_array_format) == 4 &&
+         _mesa_array_format_is_normalized(src_array_format) ==
+            _mesa_array_format_is_normalized(dst_array_format);
+   }
+
+   if (!rebase_swizzle && !ubyte4_shuffle) {
       /* Handle the cases where we can directly unpack */
       if (!src_format_is_mesa_array_format) {
          if (dst_array_format == RGBA32_FLOAT) {
@@ -821,6 +844,48 @@ swizzle_convert_try_memcpy(void *dst,
    return true;
 }
 
+/**
+ * Attempts to perform the given swizzle-and-convert operation as an R/B
+ * swap of 32-bit pixels.
+ *
+ * This covers the common case of converting between RGBA and BGRA 8-bit
+ * formats (e.g. BGRA framebuffers read back as GL_RGBA/GL_UNSIGNED_BYTE),
+ * which otherwise goes through the per-channel tmp[] array used by
+ * SWIZZLE_CONVERT_LOOP.  Other 4x8-bit permutations are left to the
+ * generic loop, which is faster than doing them with variable shifts.
+ *
+ * The arguments are exactly the same as for _mesa_swizzle_and_convert
+ *
+ * \return  true if it successfully performed the swizzle-and-convert
+ *          operation, false otherwise
+ */
+static bool
+swizzle_convert_try_ubyte4_shuffle(void *dst,
+                                   enum mesa_array_format_datatype dst_type,
+                                   int num_dst_channels,
+                                   const void *src,
+                                   enum mesa_array_format_datatype src_type,
+                                   int num_src_channels,
+                                   const uint8_t swizzle[4], bool normalized,
+                                   int count)
+{
+   if (src_type != MESA_ARRAY_FORMAT_TYPE_UBYTE ||
+       dst_type != MESA_ARRAY_FORMAT_TYPE_UBYTE)
+      return false;
+   if (num_src_channels != 4 || num_dst_channels != 4)
+      return false;
+
+   if (swizzle[0] != MESA_FORMAT_SWIZZLE_Z ||
+       swizzle[1] != MESA_FORMAT_SWIZZLE_Y ||
+       swizzle[2] != MESA_FORMAT_SWIZZLE_X ||
+       swizzle[3] != MESA_FORMAT_SWIZZLE_W)
+      return false;
+
+   convert_ubyte_rgba_to_bgra(count, 1, src, 0, dst, 0);
+
+   return true;
+}
+
 /**
  * Represents a single instance of the standard swizzle-and-convert loop
  *
@@ -1540,6 +1605,11 @@ _mesa_swizzle_and_convert(void *void_dst, enum mesa_array_format_datatype dst_ty
                                   swizzle, normalized, count))
       return;
 
+   if (swizzle_convert_try_ubyte4_shuffle(void_dst, dst_type, num_dst_channels,
+                                          void_src, src_type, num_src_channels,
+                                          swizzle, normalized, count))
+      return;
+
    switch (dst_type) {
    case MESA_ARRAY_FORMAT_TYPE_FLOAT:
       convert_float(void_dst, num_dst_channels, void_src, src_type,
@@ -82,6 +82,7 @@ USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "main/state.h"
 #include "main/varray.h"
 #include "util/bitscan.h"
+#include "util/hash_table.h"
 #include "util/u_memory.h"
 
 #include "vbo_noop.h"
@@ -317,6 +318,74 @@ merge_prims(struct gl_context *ctx, struct _mesa_prim *prim_list,
 }
 
 
+/**
+ * Legacy applications building display lists out of many small
+ * glBegin/glEnd fragments emit the same vertex over and over (shared quad
+ * corners, line segment end points, ...).  Point every index referring to
+ * a vertex that is bit-identical to an earlier vertex of the same list at
+ * that earlier vertex, so that post-transform vertex caches get hits instead
+ * of shading the duplicates again.  For softpipe this is the draw module's
+ * vsplit cache, which shades each distinct index of a segment only once.
+ * Drivers that transform the whole [min_index, max_index] range gain
+ * nothing, but lose nothing either.
+ *
+ * \param vertices  the first vertex of the list, i.e. the vertex for index
+ *                  \p base
+ * \param indices   the index buffer to rewrite in place
+ */
+static void
+dedup_vertex_indices(const fi_type *vertices, unsigned vertex_size,
+                     unsigned vertex_count, unsigned base,
+                     uint32_t *indices, int index_count)
+{
+   const unsigned vertex_bytes = vertex_size * sizeof(fi_type);
+   unsigned table_size, mask;
+   uint32_t *table, *remap;
+
+   if (vertex_count < 2 || vertex_size == 0)
+      return;
+
+   table_size = util_next_power_of_two(vertex_count * 2);
+   mask = table_size - 1;
+   table = malloc(table_size * sizeof(uint32_t));
+   remap = malloc(vertex_count * sizeof(uint32_t));
+   if (!table || !remap) {
+      /* Not fatal, the list simply stays un-deduplicated. */
+      free(table);
+      free(remap);
+      return;
+   }
+   memset(table, 0xff, table_size * sizeof(uint32_t));
+   memset(remap, 0xff, vertex_count * sizeof(uint32_t));
+
+   for (int i = 0; i < index_count; i++) {
+      const unsigned v = indices[i] - base;
+
+      if (indices[i] < base || v >= vertex_count)
+         continue;
+
+      if (remap[v] == ~0u) {
+         const fi_type *data = vertices + v * vertex_size;
+         unsigned slot = _mesa_hash_data(data, vertex_bytes) & mask;
+
+         while (table[slot] != ~0u &&
+                memcmp(vertices + table[slot] * vertex_size, data,
+                       vertex_bytes) != 0)
+            slot = (slot + 1) & mask;
+
+         if (table[slot] == ~0u)
+            table[slot] = v;
+         remap[v] = table[slot];
+      }
+
+      indices[i] = remap[v] + base;
+   }
+
+   free(table);
+   free(remap);
+}
+
+
 /**
  * Convert GL_LINE_LOOP primitive into GL_LINE_STRIP so that drivers
  * don't have to worry about handling the _mesa_prim::begin/end flags.
@@ -754,6 +823,15 @@ compile_vertex_list(struct gl_context *ctx)
 
       assert(idx <= max_indices_count);
 
+      dedup_vertex_indices(save->buffer_map, save->vertex_size,
+                           save->vert_count, start_offset, indices, idx);
+      min_index = 0xFFFFFFFF;
+      max_index = 0;
+      for (int i = 0; i < idx; i++) {
+         min_index = MIN2(min_index, indices[i]);
+         max_index = MAX2(max_index, indices[i]);
+      }
+
       node->merged.prim_count = last_valid_prim + 1;
       node->merged.ib.ptr = NULL;
       node->merged.ib.count = idx;
@@ -70,9 +70,14 @@ __declspec(align(16))
 {
 #ifndef NDEBUG
    /* A canary value used to determine whether a pointer is ralloc'd. */
-   unsigned canary;
+   unsigned canary:24;
 #endif
 
+   /* RALLOC_ARENA_BLOCK if a ralloc_arena_prefix precedes the header.
+    * Shares a word with the canary, so the header does not grow.
+    */
+   unsigned flags:8;
+
    struct ralloc_header *parent;
 
    /* The first child (head of a linked list) */
@@ -87,6 +92,48 @@ __declspec(align(16))
 
 typedef struct ralloc_header ralloc_header;
 
+/* Arena state shared by every block allocated below an arena context.
+ *
+ * Blocks are bump-allocated out of ARENA_CHUNK_SIZE chunks.  A chunk is
+ * released once every block carved out of it has been freed, no matter
+ * which context the blocks have been stolen to in the meantime, so all of
+ * the usual ralloc semantics keep working.  The arena itself stays around
+ * until the last block referring to it is gone; once the arena context is
+ * freed the arena is closed and further children are ordinary blocks.
+ *
+ * Only blocks below an arena context pay for this: their header is
+ * preceded by a ralloc_arena_prefix, flagged with RALLOC_ARENA_BLOCK.
+ */
+struct ralloc_arena {
+   ralloc_header *owner;          /* the arena context, NULL once closed */
+   struct ralloc_chunk *current;  /* chunk new blocks are carved from */
+   unsigned refcount;             /* live blocks whose prefix points here */
+};
+
+#define RALLOC_ARENA_BLOCK 0x1
+
+struct ralloc_arena_prefix {
+   /* Arena that children of this block are allocated from */
+   struct ralloc_arena *arena;
+
+   /* Arena chunk holding this block, NULL if it was malloc'ed directly */
+   struct ralloc_chunk *chunk;
+};
+
+#define ARENA_PREFIX_SIZE \
+   align64(sizeof(struct ralloc_arena_prefix), alignof(ralloc_header))
+
+struct ralloc_chunk {
+   unsigned refcount;  /* live blocks + 1 while it is the current chunk */
+   unsigned used;
+};
+
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#define ARENA_CHUNK_HEADER_SIZE \
+   align64(sizeof(struct ralloc_chunk), alignof(ralloc_header))
+/* Larger blocks are not worth wasting the rest of a chunk on. */
+#define ARENA_MAX_BLOCK_SIZE (ARENA_CHUNK_SIZE / 8)
+
 static void unlink_block(ralloc_header *info);
 static void unsafe_free(ralloc_header *info);
 
@@ -101,6 +148,15 @@ get_header(const void *ptr)
 
 #define PTR_FROM_HEADER(info) (((char *) info) + sizeof(ralloc_header))
 
+static struct ralloc_arena_prefix *
+get_arena_prefix(const ralloc_header *info)
+{
+   if (likely(!(info->flags & RALLOC_ARENA_BLOCK)))
+      return NULL;
+
+   return (struct ralloc_arena_prefix *) (((char *) info) - ARENA_PREFIX_SIZE);
+}
+
 static void
 add_child(ralloc_header *parent, ralloc_header *info)
 {
@@ -120,8 +176,60 @@ ralloc_context(const void *ctx)
    return ralloc_size(ctx, 0);
 }
 
-void *
-ralloc_size(const void *ctx, size_t size)
+static void
+chunk_unref(struct ralloc_chunk *chunk)
+{
+   if (--chunk->refcount == 0)
+      free(chunk);
+}
+
+/* Carve a block (prefix included) out of the arena's current chunk,
+ * starting a new chunk if it is full.  Returns NULL if the block should be
+ * malloc'ed instead.
+ */
+static struct ralloc_arena_prefix *
+arena_alloc(struct ralloc_arena *arena, size_t block_size)
+{
+   struct ralloc_chunk *chunk = arena->current;
+   struct ralloc_arena_prefix *prefix;
+
+   if (block_size > ARENA_MAX_BLOCK_SIZE)
+      return NULL;
+
+   if (chunk == NULL || chunk->used + block_size > ARENA_CHUNK_SIZE) {
+      chunk = malloc(ARENA_CHUNK_SIZE);
+      if (unlikely(chunk == NULL))
+         return NULL;
+
+      chunk->refcount = 1;
+      chunk->used = ARENA_CHUNK_HEADER_SIZE;
+
+      if (arena->current != NULL)
+         chunk_unref(arena->current);
+      arena->current = chunk;
+   }
+
+   prefix = (struct ralloc_arena_prefix *) ((char *) chunk + chunk->used);
+   prefix->chunk = chunk;
+   chunk->used += block_size;
+   chunk->refcount++;
+   return prefix;
+}
+
+static void
+arena_unref(struct ralloc_arena *arena)
+{
+   if (--arena->refcount == 0) {
+      assert(arena->owner == NULL && arena->current == NULL);
+      free(arena);
+   }
+}
+
+/* Allocate a block below parent.  Blocks with an arena get a prefix and
+ * are carved from the arena's chunks while it is open.
+ */
+static void *
+alloc_block(ralloc_header *parent, size_t size, struct ralloc_arena *arena)
 {
    /* Some malloc allocation doesn't always align to 16 bytes even on 64 bits
     * system, from Android bionic/tests/malloc_test.cpp:
@@ -130,15 +238,34 @@ ralloc_size(const void *ctx, size_t size)
     *  - Allocations of a size that rounds up to a multiple of 8 bytes and
     *    not 16 bytes, are only required to have at least 8 byte alignment.
     */
-   void *block = malloc(align64(size + sizeof(ralloc_header),
-                                alignof(ralloc_header)));
+   size_t block_size = align64(size + sizeof(ralloc_header),
+                               alignof(ralloc_header));
    ralloc_header *info;
-   ralloc_header *parent;
 
-   if (unlikely(block == NULL))
-      return NULL;
+   if (likely(arena == NULL)) {
+      info = malloc(block_size);
+      if (unlikely(info == NULL))
+         return NULL;
+      info->flags = 0;
+   } else {
+      struct ralloc_arena_prefix *prefix = NULL;
+
+      block_size += ARENA_PREFIX_SIZE;
+      if (arena->owner != NULL)
+         prefix = arena_alloc(arena, block_size);
+      if (prefix == NULL) {
+         prefix = malloc(block_size);
+         if (unlikely(prefix == NULL))
+            return NULL;
+         prefix->chunk = NULL;
+      }
+      prefix->arena = arena;
+      arena->refcount++;
+
+      info = (ralloc_header *) ((char *) prefix + ARENA_PREFIX_SIZE);
+      info->flags = RALLOC_ARENA_BLOCK;
+   }
 
-   info = (ralloc_header *) block;
    /* measurements have shown that calloc is slower (because of
     * the multiplication overflow checking?), so clear things
     * manually
@@ -149,8 +276,6 @@ ralloc_size(const void *ctx, size_t size)
    info->next = NULL;
    info->destructor = NULL;
 
-   parent = ctx != NULL ? get_header(ctx) : NULL;
-
    add_child(parent, info);
 
 #ifndef NDEBUG
@@ -160,6 +285,21 @@ ralloc_size(const void *ctx, size_t size)
    return PTR_FROM_HEADER(info);
 }
 
+void *
+ralloc_size(const void *ctx, size_t size)
+{
+   ralloc_header *parent = ctx != NULL ? get_header(ctx) : NULL;
+   struct ralloc_arena_prefix *prefix;
+   struct ralloc_arena *arena = NULL;
+
+   /* Children of a closed arena are ordinary blocks again. */
+   if (parent != NULL && (prefix = get_arena_prefix(parent)) != NULL &&
+       prefix->arena->owner != NULL)
+      arena = prefix->arena;
+
+   return alloc_block(parent, size, arena);
+}
+
 void *
 rzalloc_size(const void *ctx, size_t size)
 {
@@ -171,18 +311,72 @@ rzalloc_size(const void *ctx, size_t size)
    return ptr;
 }
 
+void *
+ralloc_arena_context(const void *ctx)
+{
+   struct ralloc_arena *arena;
+   void *ptr;
+
+   arena = malloc(sizeof(*arena));
+   if (unlikely(arena == NULL))
+      return NULL;
+
+   /* Not open yet, so the context itself is malloc'ed with a prefix. */
+   arena->owner = NULL;
+   arena->current = NULL;
+   arena->refcount = 0;
+
+   ptr = alloc_block(ctx != NULL ? get_header(ctx) : NULL, 0, arena);
+   if (unlikely(ptr == NULL)) {
+      free(arena);
+      return NULL;
+   }
+
+   arena->owner = get_header(ptr);
+   return ptr;
+}
+
 /* helper function - assumes ptr != NULL */
 static void *
 resize(void *ptr, size_t size)
 {
    ralloc_header *child, *old, *info;
+   struct ralloc_arena_prefix *prefix, *new_prefix;
+   size_t block_size = align64(size + sizeof(ralloc_header),
+                               alignof(ralloc_header));
 
    old = get_header(ptr);
-   info = realloc(old, align64(size + sizeof(ralloc_header),
-                               alignof(ralloc_header)));
-
-   if (info == NULL)
-      return NULL;
+   prefix = get_arena_prefix(old);
+   if (likely(prefix == NULL)) {
+      info = realloc(old, block_size);
+      if (info == NULL)
+         return NULL;
+   } else {
+      block_size += ARENA_PREFIX_SIZE;
+      if (prefix->chunk != NULL) {
+         /* Blocks living in an arena chunk can't be grown in place, move
+          * them to the heap.  We don't know the old size, but copying up to
+          * the end of the chunk is always safe and covers it.
+          */
+         size_t avail = ARENA_CHUNK_SIZE -
+                        ((char *) prefix - (char *) prefix->chunk);
+
+         new_prefix = malloc(block_size);
+         if (new_prefix == NULL)
+            return NULL;
+
+         memcpy(new_prefix, prefix, MIN2(block_size, avail));
+         new_prefix->chunk = NULL;
+         chunk_unref(prefix->chunk);
+      } else {
+         new_prefix = realloc(prefix, block_size);
+         if (new_prefix == NULL)
+            return NULL;
+      }
+      info = (ralloc_header *) ((char *) new_prefix + ARENA_PREFIX_SIZE);
+      if (new_prefix->arena->owner == old)
+         new_prefix->arena->owner = info;
+   }
 
    /* Update parent and sibling's links to the reallocated node. */
    if (info != old && info->parent != NULL) {
@@ -302,6 +496,8 @@ unsafe_free(ralloc_header *info)
 {
    /* Recursively free any children...don't waste time unlinking them. */
    ralloc_header *temp;
+   struct ralloc_arena_prefix *prefix;
+   struct ralloc_arena *arena;
    while (info->child != NULL) {
       temp = info->child;
       info->child = temp->next;
@@ -312,7 +508,28 @@ unsafe_free(ralloc_header *info)
    if (info->destructor != NULL)
       info->destructor(PTR_FROM_HEADER(info));
 
-   free(info);
+   prefix = get_arena_prefix(info);
+   if (likely(prefix == NULL)) {
+      free(info);
+      return;
+   }
+
+   arena = prefix->arena;
+   if (arena->owner == info) {
+      /* The arena context is going away, close the arena. */
+      arena->owner = NULL;
+      if (arena->current != NULL) {
+         chunk_unref(arena->current);
+         arena->current = NULL;
+      }
+   }
+
+   if (prefix->chunk != NULL)
+      chunk_unref(prefix->chunk);
+   else
+      free(prefix);
+
+   arena_unref(arena);
 }
 
 void
@@ -91,6 +91,29 @@ extern "C" {
  */
 void *ralloc_context(const void *ctx);
 
+/**
+ * Allocate a new ralloc context whose descendants are arena allocated.
+ *
+ * Every block allocated below the returned context (directly or through
+ * any of its descendants) is bump-allocated out of large chunks instead of
+ * calling \c malloc for each block, and freeing the context releases the
+ * chunks in bulk.  This is meant for passes that allocate many small,
+ * short-lived objects.
+ *
+ * All ralloc functions keep working as usual on the blocks: they can be
+ * freed, resized and stolen to other contexts.  A chunk is only released
+ * once every block carved out of it is gone, so stealing long-lived objects
+ * out of an arena context keeps its chunks alive.  That is the difference
+ * from the linear allocator below, whose nodes can neither be freed, stolen
+ * nor have destructors, so existing ralloc users can switch to an arena
+ * context without changing how they allocate.
+ *
+ * The chunk and arena reference counts are not atomic.  An arena context
+ * and everything below it must only be used from one thread at a time,
+ * including blocks that have been stolen out of it.
+ */
+void *ralloc_arena_context(const void *ctx);
+
 /**
  * Allocate memory chained off of the given context.
  *
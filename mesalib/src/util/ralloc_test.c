@@ -0,0 +1,165 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* Unit tests for ralloc arena contexts.  Best run under a leak checker. */
+
+#undef NDEBUG
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ralloc.h"
+
+static unsigned destructor_calls;
+
+static void
+count_destructor(void *ptr)
+{
+   destructor_calls++;
+}
+
+static void
+fill(void *ptr, size_t size, unsigned seed)
+{
+   for (size_t i = 0; i < size; i++)
+      ((uint8_t *) ptr)[i] = (uint8_t) (seed + i);
+}
+
+static void
+check(const void *ptr, size_t size, unsigned seed)
+{
+   for (size_t i = 0; i < size; i++)
+      assert(((const uint8_t *) ptr)[i] == (uint8_t) (seed + i));
+}
+
+/* Enough blocks to span several chunks, freed in a scattered order. */
+static void
+test_many_blocks(void)
+{
+   void *arena = ralloc_arena_context(NULL);
+   void *blocks[20000];
+
+   for (unsigned i = 0; i < 20000; i++) {
+      blocks[i] = ralloc_size(arena, 1 + i % 100);
+      assert(ralloc_parent(blocks[i]) == arena);
+      fill(blocks[i], 1 + i % 100, i);
+   }
+   for (unsigned i = 0; i < 20000; i += 3)
+      ralloc_free(blocks[i]);
+   for (unsigned i = 1; i < 20000; i += 3)
+      check(blocks[i], 1 + i % 100, i);
+
+   ralloc_free(arena);
+}
+
+/* Blocks stolen out of an arena outlive the arena context. */
+static void
+test_steal(void)
+{
+   void *heap = ralloc_context(NULL);
+   void *arena = ralloc_arena_context(heap);
+   char *kept = ralloc_size(arena, 64);
+   char *child = ralloc_size(kept, 32);
+   char *late;
+
+   fill(kept, 64, 1);
+   fill(child, 32, 2);
+   ralloc_set_destructor(child, count_destructor);
+
+   ralloc_steal(heap, kept);
+   assert(ralloc_parent(kept) == heap);
+   ralloc_free(arena);
+   check(kept, 64, 1);
+   check(child, 32, 2);
+
+   /* The arena is closed, new children are ordinary blocks. */
+   late = ralloc_size(kept, 16);
+   fill(late, 16, 3);
+   assert(ralloc_parent(late) == kept);
+
+   destructor_calls = 0;
+   ralloc_free(heap);
+   assert(destructor_calls == 1);
+}
+
+/* Growing a block moves it out of its chunk, keeping links and contents. */
+static void
+test_reralloc(void)
+{
+   void *arena = ralloc_arena_context(NULL);
+   char *block = ralloc_size(arena, 40);
+   char *child = ralloc_size(block, 8);
+   char *sibling = ralloc_size(arena, 8);
+
+   fill(block, 40, 4);
+   block = reralloc_size(arena, block, 100000);
+   check(block, 40, 4);
+   fill(block, 100000, 5);
+   assert(ralloc_parent(child) == block);
+   assert(ralloc_parent(block) == arena);
+
+   block = reralloc_size(arena, block, 200000);
+   check(block, 100000, 5);
+   block = reralloc_size(arena, block, 16);
+   check(block, 16, 5);
+
+   /* Resizing the arena context itself keeps the arena working. */
+   arena = reralloc_size(NULL, arena, 256);
+   assert(ralloc_parent(block) == arena);
+   assert(ralloc_parent(sibling) == arena);
+   child = ralloc_size(arena, 8);
+   assert(ralloc_parent(child) == arena);
+
+   ralloc_free(arena);
+}
+
+/* The parent of an arena context, and of a nested arena, frees it all. */
+static void
+test_free_after_parent_free(void)
+{
+   void *heap = ralloc_context(NULL);
+   void *arena = ralloc_arena_context(heap);
+   void *nested = ralloc_arena_context(ralloc_size(arena, 8));
+   void *other = ralloc_context(NULL);
+   unsigned i;
+
+   destructor_calls = 0;
+   for (i = 0; i < 100; i++) {
+      ralloc_set_destructor(ralloc_size(arena, 24), count_destructor);
+      ralloc_set_destructor(ralloc_size(nested, 24), count_destructor);
+   }
+   ralloc_steal(other, ralloc_size(nested, 24));
+
+   ralloc_free(heap);
+   assert(destructor_calls == 200);
+   ralloc_free(other);
+}
+
+int
+main(void)
+{
+   test_many_blocks();
+   test_steal();
+   test_reralloc();
+   test_free_after_parent_free();
+   return 0;
+}
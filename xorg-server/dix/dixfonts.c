@@ -231,6 +231,188 @@ FreeFPE(FontPathElementPtr fpe)
     }
 }
 
+/*
+ * With -prerasterize, newly opened fonts have their glyphs fetched a
+ * chunk at a time from a short timer, i.e. between requests, so that a
+ * large scalable font is mostly rasterised by the time it is first used
+ * instead of stalling that first text request.  A timer is used rather
+ * than the work queue because work procs only run when something else
+ * wakes the server up.  Each pending font holds a reference, dropped
+ * when we are done or nobody else uses it any more.
+ */
+#define PRERASTERIZE_CHUNK  64
+#define PRERASTERIZE_DELAY  1       /* ms between chunks */
+#define PRERASTERIZE_MAX    32768   /* glyphs, enough for the CJK blocks */
+
+typedef struct _PrerasterizeRange {
+    unsigned char firstRow, lastRow, firstCol, lastCol;
+} PrerasterizeRangeRec;
+
+/* Latin-1, CJK punctuation and kana, CJK Unified Ideographs, Hangul
+ * syllables, fullwidth forms */
+static const PrerasterizeRangeRec iso10646Ranges[] = {
+    { 0x00, 0x00, 0x20, 0xff },
+    { 0x30, 0x30, 0x00, 0xff },
+    { 0x4e, 0x9f, 0x00, 0xff },
+    { 0xac, 0xd7, 0x00, 0xff },
+    { 0xff, 0xff, 0x00, 0xff },
+};
+
+typedef struct _PrerasterizeClosure {
+    struct _PrerasterizeClosure *next;
+    FontPtr pFont;
+    OsTimerPtr timer;
+    const PrerasterizeRangeRec *range, *lastRange;
+    PrerasterizeRangeRec fontRange;     /* for fonts that are not iso10646 */
+    CharInfoPtr pDefault;
+    unsigned int row, col;      /* next character to fetch */
+    unsigned int count;         /* glyphs actually present so far */
+} PrerasterizeClosureRec, *PrerasterizeClosurePtr;
+
+static PrerasterizeClosurePtr prerasterizePending;
+
+static void
+PrerasterizeFontDone(PrerasterizeClosurePtr c)
+{
+    PrerasterizeClosurePtr *prev;
+
+    for (prev = &prerasterizePending; *prev; prev = &(*prev)->next) {
+        if (*prev == c) {
+            *prev = c->next;
+            break;
+        }
+    }
+    TimerFree(c->timer);
+    CloseFont(c->pFont, (Font) 0);
+    free(c);
+}
+
+static Bool
+FontIsISO10646(FontPtr pFont)
+{
+    Atom registry = MakeAtom("CHARSET_REGISTRY", 16, FALSE);
+    const char *value;
+    int i;
+
+    if (registry == None)
+        return FALSE;
+    for (i = 0; i < pFont->info.nprops; i++) {
+        if (pFont->info.props[i].name == registry &&
+            pFont->info.isStringProp[i]) {
+            value = NameForAtom(pFont->info.props[i].value);
+            return value && strcasecmp(value, "ISO10646") == 0;
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * Move to the first character of the current range, or of a later one,
+ * that lies within the font.  Returns FALSE when there is none left.
+ */
+static Bool
+PrerasterizeStartRange(PrerasterizeClosurePtr c)
+{
+    FontInfoPtr info = &c->pFont->info;
+
+    for (; c->range <= c->lastRange; c->range++) {
+        c->row = max(c->range->firstRow, info->firstRow);
+        c->col = max(c->range->firstCol, info->firstCol);
+        if (c->row <= min(c->range->lastRow, info->lastRow) &&
+            c->col <= min(c->range->lastCol, info->lastCol))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static CARD32
+PrerasterizeFontWork(OsTimerPtr timer, CARD32 now, void *closure)
+{
+    PrerasterizeClosurePtr c = closure;
+    FontPtr pFont = c->pFont;
+    unsigned int lastRow, firstCol, lastCol;
+    unsigned char chars[PRERASTERIZE_CHUNK * 2];
+    CharInfoPtr glyphs[PRERASTERIZE_CHUNK];
+    unsigned long nglyphs, i;
+    int n = 0;
+
+    if (pFont->refcnt == 1 || c->count >= PRERASTERIZE_MAX ||
+        c->range > c->lastRange) {
+        PrerasterizeFontDone(c);
+        return 0;
+    }
+    lastRow = min(c->range->lastRow, pFont->info.lastRow);
+    firstCol = max(c->range->firstCol, pFont->info.firstCol);
+    lastCol = min(c->range->lastCol, pFont->info.lastCol);
+    while (n < PRERASTERIZE_CHUNK) {
+        chars[2 * n] = c->row;
+        chars[2 * n + 1] = c->col;
+        n++;
+        if (c->col++ == lastCol) {
+            c->col = firstCol;
+            if (c->row++ == lastRow) {
+                c->range++;
+                if (!PrerasterizeStartRange(c))
+                    break;
+                lastRow = min(c->range->lastRow, pFont->info.lastRow);
+                firstCol = max(c->range->firstCol, pFont->info.firstCol);
+                lastCol = min(c->range->lastCol, pFont->info.lastCol);
+            }
+        }
+    }
+    (*pFont->get_glyphs) (pFont, n, chars, TwoD16Bit, &nglyphs, glyphs);
+    /* missing characters come back as the default glyph or not at all */
+    for (i = 0; i < nglyphs; i++)
+        if (glyphs[i] != c->pDefault)
+            c->count++;
+    return PRERASTERIZE_DELAY;
+}
+
+static void
+PrerasterizeFont(FontPtr pFont)
+{
+    PrerasterizeClosurePtr c;
+    unsigned char defaultChar[2];
+    unsigned long nglyphs;
+
+    /* font server glyphs have to be loaded asynchronously first */
+    if (fpe_functions[pFont->fpe->type]->load_glyphs)
+        return;
+    c = malloc(sizeof(PrerasterizeClosureRec));
+    if (!c)
+        return;
+    c->pFont = pFont;
+    if (FontIsISO10646(pFont)) {
+        c->range = iso10646Ranges;
+        c->lastRange = &iso10646Ranges[ARRAY_SIZE(iso10646Ranges) - 1];
+    }
+    else {
+        c->fontRange.firstRow = pFont->info.firstRow;
+        c->fontRange.lastRow = pFont->info.lastRow;
+        c->fontRange.firstCol = pFont->info.firstCol;
+        c->fontRange.lastCol = pFont->info.lastCol;
+        c->range = c->lastRange = &c->fontRange;
+    }
+    if (!PrerasterizeStartRange(c)) {
+        free(c);
+        return;
+    }
+    defaultChar[0] = pFont->info.defaultCh >> 8;
+    defaultChar[1] = pFont->info.defaultCh;
+    c->pDefault = NULL;
+    (*pFont->get_glyphs) (pFont, 1, defaultChar, TwoD16Bit, &nglyphs,
+                          &c->pDefault);
+    c->count = 0;
+    c->timer = TimerSet(NULL, 0, PRERASTERIZE_DELAY, PrerasterizeFontWork, c);
+    if (!c->timer) {
+        free(c);
+        return;
+    }
+    pFont->refcnt++;
+    c->next = prerasterizePending;
+    prerasterizePending = c;
+}
+
 static Bool
 doOpenFont(ClientPtr client, OFclosurePtr c)
 {
@@ -360,6 +542,8 @@ doOpenFont(ClientPtr client, OFclosurePtr c)
     if (patternCache && pfont != c->non_cachable_font)
         xfont2_cache_font_pattern(patternCache, c->origFontName, c->origFontNameLen,
                                   pfont);
+    if (prerasterizeFonts && pfont->refcnt == 1)
+        PrerasterizeFont(pfont);
  bail:
     if (err != Successful && c->client != serverClient) {
         SendErrorToClient(c->client, X_OpenFont, 0,
@@ -1905,6 +2089,8 @@ get_client_resolutions(int *num)
 void
 FreeFonts(void)
 {
+    while (prerasterizePending)
+        PrerasterizeFontDone(prerasterizePending);
     if (patternCache) {
         xfont2_free_font_pattern_cache(patternCache);
         patternCache = 0;
@@ -103,6 +103,7 @@ Bool screenSaverSuspended = FALSE;
 #endif
 
 const char *defaultFontPath = COMPILEDDEFAULTFONTPATH;
+Bool prerasterizeFonts = FALSE;
 FontPtr defaultFont;            /* not declared in dix.h to avoid including font.h in
                                    every compilation of dix code */
 CursorPtr rootCursor;
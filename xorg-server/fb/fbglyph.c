@@ -53,6 +53,72 @@ fbGlyphIn(RegionPtr pRegion, int x, int y, int width, int height)
     return RegionContainsRect(pRegion, &box) == rgnIN;
 }
 
+/*
+ * Check whether a whole string of glyphs can go through the fast glyph
+ * functions without any clipping, so that the region only has to be
+ * consulted once per request instead of once per glyph.
+ */
+static Bool
+fbGlyphsIn(RegionPtr pRegion, int x, int y,
+           unsigned int nglyph, CharInfoPtr * ppci)
+{
+    CharInfoPtr pci;
+    int x1 = MAXSHORT, y1 = MAXSHORT, x2 = MINSHORT, y2 = MINSHORT;
+    int gx, gWidth, gHeight;
+
+    while (nglyph--) {
+        pci = *ppci++;
+        gWidth = GLYPHWIDTHPIXELS(pci);
+        gHeight = GLYPHHEIGHTPIXELS(pci);
+        if (gWidth && gHeight) {
+            if (gWidth > sizeof(FbStip) * 8)
+                return FALSE;
+            gx = x + pci->metrics.leftSideBearing;
+            if (gx < x1)
+                x1 = gx;
+            if (gx + gWidth > x2)
+                x2 = gx + gWidth;
+            if (y - pci->metrics.ascent < y1)
+                y1 = y - pci->metrics.ascent;
+            if (y + pci->metrics.descent > y2)
+                y2 = y + pci->metrics.descent;
+        }
+        x += pci->metrics.characterWidth;
+    }
+    if (x1 >= x2)
+        return TRUE;
+    return fbGlyphIn(pRegion, x1, y1, x2 - x1, y2 - y1);
+}
+
+/* Draw a string known to pass fbGlyphsIn */
+static void
+fbGlyphsUnclipped(DrawablePtr pDrawable,
+                  void (*glyph) (FbBits *, FbStride, int, FbStip *, FbBits,
+                                 int, int),
+                  FbBits fg, int x, int y,
+                  unsigned int nglyph, CharInfoPtr * ppci, void *pglyphBase)
+{
+    CharInfoPtr pci;
+    int gHeight;
+    FbBits *dst;
+    FbStride dstStride;
+    int dstBpp;
+    int dstXoff, dstYoff;
+
+    fbGetDrawable(pDrawable, dst, dstStride, dstBpp, dstXoff, dstYoff);
+    while (nglyph--) {
+        pci = *ppci++;
+        gHeight = GLYPHHEIGHTPIXELS(pci);
+        if (GLYPHWIDTHPIXELS(pci) && gHeight)
+            (*glyph) (dst + (y - pci->metrics.ascent + dstYoff) * dstStride,
+                      dstStride, dstBpp,
+                      (FbStip *) FONTGLYPHBITS(pglyphBase, pci), fg,
+                      x + pci->metrics.leftSideBearing + dstXoff, gHeight);
+        x += pci->metrics.characterWidth;
+    }
+    fbFinishAccess(pDrawable);
+}
+
 void
 fbPolyGlyphBlt(DrawablePtr pDrawable,
                GCPtr pGC,
@@ -90,6 +156,12 @@ fbPolyGlyphBlt(DrawablePtr pDrawable,
     x += pDrawable->x;
     y += pDrawable->y;
 
+    if (glyph && fbGlyphsIn(fbGetCompositeClip(pGC), x, y, nglyph, ppci)) {
+        fbGlyphsUnclipped(pDrawable, glyph, pPriv->xor, x, y,
+                          nglyph, ppci, pglyphBase);
+        return;
+    }
+
     while (nglyph--) {
         pci = *ppci++;
         pglyph = FONTGLYPHBITS(pglyphBase, pci);
@@ -191,6 +263,13 @@ fbImageGlyphBlt(DrawablePtr pDrawable,
         opaque = FALSE;
     }
 
+    if (glyph &&
+        fbGlyphsIn(fbGetCompositeClip(pGC), x, y, nglyph, ppciInit)) {
+        fbGlyphsUnclipped(pDrawable, glyph, pPriv->fg, x, y,
+                          nglyph, ppciInit, pglyphBase);
+        return;
+    }
+
     ppci = ppciInit;
     while (nglyph--) {
         pci = *ppci++;
@@ -2067,9 +2067,11 @@ __glXDisp_Render(__GLXclientState * cl, GLbyte * pc)
     ClientPtr client = cl->client;
     int left, cmdlen, error;
     int commandsDone;
-    CARD16 opcode;
+    CARD16 opcode, lastOpcode;
     __GLXrenderHeader *hdr;
     __GLXcontext *glxc;
+    __GLXrenderSizeData entry;
+    __GLXdispatchRenderProcPtr proc, lastProc;
 
     __GLX_DECLARE_SWAP_VARIABLES;
 
@@ -2089,10 +2091,17 @@ __glXDisp_Render(__GLXclientState * cl, GLbyte * pc)
     commandsDone = 0;
     pc += sz_xGLXRenderReq;
     left = (req->length << 2) - sz_xGLXRenderReq;
+
+    /*
+     ** Immediate mode clients send long runs of the same command
+     ** (glVertex3fv, glColor4ubv, ...).  Remember the size data and decode
+     ** function of the previous command so such runs only pay for the
+     ** dispatch table lookups once.
+     */
+    lastOpcode = 0;
+    lastProc = NULL;
     while (left > 0) {
-        __GLXrenderSizeData entry;
         int extra = 0;
-        __GLXdispatchRenderProcPtr proc;
         int err;
 
         if (left < sizeof(__GLXrenderHeader))
@@ -2116,14 +2125,22 @@ __glXDisp_Render(__GLXclientState * cl, GLbyte * pc)
         /*
          ** Check for core opcodes and grab entry data.
          */
-        err = __glXGetProtocolSizeData(&Render_dispatch_info, opcode, &entry);
-        proc = (__GLXdispatchRenderProcPtr)
-            __glXGetProtocolDecodeFunction(&Render_dispatch_info,
-                                           opcode, client->swapped);
+        if (opcode != lastOpcode || lastProc == NULL) {
+            err = __glXGetProtocolSizeData(&Render_dispatch_info, opcode,
+                                           &entry);
+            proc = (__GLXdispatchRenderProcPtr)
+                __glXGetProtocolDecodeFunction(&Render_dispatch_info,
+                                               opcode, client->swapped);
 
-        if ((err < 0) || (proc == NULL)) {
-            client->errorValue = commandsDone;
-            return __glXError(GLXBadRenderRequest);
+            if ((err < 0) || (proc == NULL)) {
+                client->errorValue = commandsDone;
+                return __glXError(GLXBadRenderRequest);
+            }
+            lastOpcode = opcode;
+            lastProc = proc;
+        }
+        else {
+            proc = lastProc;
         }
 
         if (cmdlen < entry.bytes) {
@@ -2155,6 +2172,25 @@ __glXDisp_Render(__GLXclientState * cl, GLbyte * pc)
         pc += cmdlen;
         left -= cmdlen;
         commandsDone++;
+
+        /*
+         ** Execute the rest of a run of the same fixed size command
+         ** straight away.  Its size and decode function are known to be
+         ** good, so only the header has to match.  Byte-swapped clients
+         ** take the general path above.
+         */
+        if (!entry.varsize && !client->swapped) {
+            while (left >= cmdlen) {
+                hdr = (__GLXrenderHeader *) pc;
+                if (hdr->opcode != opcode || hdr->length != cmdlen)
+                    break;
+
+                (*proc) (pc + __GLX_RENDER_HDR_SIZE);
+                pc += cmdlen;
+                left -= cmdlen;
+                commandsDone++;
+            }
+        }
     }
     return Success;
 }
@@ -35,6 +35,12 @@
  * Silicon Graphics, Inc.
  */
 
+/*
+** Number of implementation-dependent limits shadowed per context,
+** see DoGetv in single2.c.
+*/
+#define __GLX_GET_CACHE_SIZE 32
+
 struct __GLXcontext {
     void (*destroy) (__GLXcontext * context);
     int (*makeCurrent) (__GLXcontext * context);
@@ -127,6 +133,19 @@ struct __GLXcontext {
     GLbyte *largeCmdBuf;
     GLint largeCmdBufSize;
 
+    /*
+     ** Shadow copies of implementation-dependent limits, so that repeated
+     ** GetIntegerv/GetFloatv single requests for them can be answered
+     ** without calling into the GL.  Bit n of the valid masks is set once
+     ** entry n has been filled in.
+     */
+    GLuint getCacheIntValid;
+    GLuint getCacheFloatValid;
+    GLint getCacheInt[__GLX_GET_CACHE_SIZE][2];
+    GLfloat getCacheFloat[__GLX_GET_CACHE_SIZE][2];
+    unsigned long getCacheHits;         /* queries answered from the cache */
+    unsigned long getCacheMisses;       /* cacheable queries sent to the GL */
+
     /*
      ** The drawable private this context is bound to
      */
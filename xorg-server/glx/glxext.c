@@ -180,6 +180,12 @@ __glXFreeContext(__GLXcontext * cx)
 
     __glXRemoveFromContextList(cx);
 
+    if (cx->getCacheHits || cx->getCacheMisses)
+        LogMessageVerb(X_INFO, 4,
+                       "GLX: context freed, %lu of %lu cacheable "
+                       "GetIntegerv/GetFloatv queries answered without the GL\n",
+                       cx->getCacheHits, cx->getCacheHits + cx->getCacheMisses);
+
     free(cx->feedbackBuf);
     free(cx->selectBuf);
     free(cx->largeCmdBuf);
@@ -71,6 +71,8 @@ extern GLboolean __glXErrorOccured(void);
 
 extern const char GLServerVersion[];
 extern int DoGetString(__GLXclientState * cl, GLbyte * pc, GLboolean need_swap);
+extern int DoGetv(__GLXclientState * cl, GLbyte * pc, GLboolean isFloat,
+                  GLboolean need_swap);
 
 extern int
 xorgGlxMakeCurrent(ClientPtr client, GLXContextTag tag, XID drawId, XID readId,
@@ -41,6 +41,8 @@
 #include "glxutil.h"
 #include "glxext.h"
 #include "indirect_dispatch.h"
+#include "indirect_size_get.h"
+#include "indirect_util.h"
 #include "unpack.h"
 
 #include "glfunctions.h"
@@ -325,6 +327,191 @@ __glXcombine_strings(const char *cext_string, const char *sext_string)
     return combo_string;
 }
 
+/*
+** Implementation-dependent limits that cannot change over the lifetime of
+** a context and are valid query targets in every GL version the server
+** exposes to indirect clients, so querying them never raises an error.
+** Framebuffer dependent values (GL_DOUBLEBUFFER, GL_*_BITS, ...) must not
+** be listed here.
+*/
+static const struct {
+    GLenum pname;
+    GLint count;
+} __glXCacheableGets[] = {
+    { GL_MAX_LIGHTS, 1 },
+    { GL_MAX_CLIP_PLANES, 1 },
+    { GL_MAX_TEXTURE_SIZE, 1 },
+    { GL_MAX_3D_TEXTURE_SIZE, 1 },
+    { GL_MAX_CUBE_MAP_TEXTURE_SIZE, 1 },
+    { GL_MAX_TEXTURE_UNITS, 1 },
+    { GL_MAX_TEXTURE_LOD_BIAS, 1 },
+    { GL_MAX_PIXEL_MAP_TABLE, 1 },
+    { GL_MAX_ATTRIB_STACK_DEPTH, 1 },
+    { GL_MAX_CLIENT_ATTRIB_STACK_DEPTH, 1 },
+    { GL_MAX_MODELVIEW_STACK_DEPTH, 1 },
+    { GL_MAX_PROJECTION_STACK_DEPTH, 1 },
+    { GL_MAX_TEXTURE_STACK_DEPTH, 1 },
+    { GL_MAX_NAME_STACK_DEPTH, 1 },
+    { GL_MAX_LIST_NESTING, 1 },
+    { GL_MAX_EVAL_ORDER, 1 },
+    { GL_MAX_ELEMENTS_VERTICES, 1 },
+    { GL_MAX_ELEMENTS_INDICES, 1 },
+    { GL_SUBPIXEL_BITS, 1 },
+    { GL_MAX_VIEWPORT_DIMS, 2 },
+    { GL_ALIASED_POINT_SIZE_RANGE, 2 },
+    { GL_ALIASED_LINE_WIDTH_RANGE, 2 },
+    { GL_SMOOTH_POINT_SIZE_RANGE, 2 },
+    { GL_SMOOTH_POINT_SIZE_GRANULARITY, 1 },
+    { GL_SMOOTH_LINE_WIDTH_RANGE, 2 },
+    { GL_SMOOTH_LINE_WIDTH_GRANULARITY, 1 },
+};
+
+/*
+** Each table entry owns one bit of the getCache*Valid masks and one row of
+** the getCache* arrays; fail the build if the table outgrows either.
+*/
+typedef char __glXCacheableGetsFit
+    [(ARRAY_SIZE(__glXCacheableGets) <= __GLX_GET_CACHE_SIZE &&
+      __GLX_GET_CACHE_SIZE <= 32) ? 1 : -1];
+
+static int
+__glXCacheableGetIndex(GLenum pname)
+{
+    int i;
+
+    for (i = 0; i < ARRAY_SIZE(__glXCacheableGets); i++) {
+        if (__glXCacheableGets[i].pname == pname)
+            return i;
+    }
+    return -1;
+}
+
+/*
+** Answer a GetIntegerv/GetFloatv query for an implementation-dependent
+** limit from the context's shadow copy.  Returns GL_FALSE if the value has
+** to be fetched from the GL, in which case the caller should hand the result
+** to __glXPutCachedv.
+*/
+static GLboolean
+__glXGetCachedv(__GLXcontext * cx, GLenum pname, GLboolean isFloat,
+                void *params)
+{
+    int i = __glXCacheableGetIndex(pname);
+
+    if (i < 0)
+        return GL_FALSE;
+
+    if (isFloat) {
+        if (!(cx->getCacheFloatValid & (1U << i)))
+            goto miss;
+        memcpy(params, cx->getCacheFloat[i],
+               __glXCacheableGets[i].count * sizeof(GLfloat));
+    }
+    else {
+        if (!(cx->getCacheIntValid & (1U << i)))
+            goto miss;
+        memcpy(params, cx->getCacheInt[i],
+               __glXCacheableGets[i].count * sizeof(GLint));
+    }
+    cx->getCacheHits++;
+    return GL_TRUE;
+
+ miss:
+    cx->getCacheMisses++;
+    return GL_FALSE;
+}
+
+static void
+__glXPutCachedv(__GLXcontext * cx, GLenum pname, GLboolean isFloat,
+                const void *params)
+{
+    int i = __glXCacheableGetIndex(pname);
+
+    if (i < 0)
+        return;
+
+    if (isFloat) {
+        memcpy(cx->getCacheFloat[i], params,
+               __glXCacheableGets[i].count * sizeof(GLfloat));
+        cx->getCacheFloatValid |= 1U << i;
+    }
+    else {
+        memcpy(cx->getCacheInt[i], params,
+               __glXCacheableGets[i].count * sizeof(GLint));
+        cx->getCacheIntValid |= 1U << i;
+    }
+}
+
+int
+DoGetv(__GLXclientState * cl, GLbyte * pc, GLboolean isFloat,
+       GLboolean need_swap)
+{
+    ClientPtr client = cl->client;
+    __GLXcontext *cx;
+    GLenum pname;
+    GLuint compsize;
+    GLint answerBuffer[200];
+    void *params;
+
+    __GLX_DECLARE_SWAP_VARIABLES;
+    __GLX_DECLARE_SWAP_ARRAY_VARIABLES;
+    int error;
+
+    REQUEST_FIXED_SIZE(xGLXSingleReq, 4);
+
+    /* If the client has the opposite byte order, swap the contextTag and
+     * the pname.
+     */
+    if (need_swap) {
+        __GLX_SWAP_INT(pc + 4);
+        __GLX_SWAP_INT(pc + __GLX_SINGLE_HDR_SIZE);
+    }
+
+    cx = __glXForceCurrent(cl, __GLX_GET_SINGLE_CONTEXT_TAG(pc), &error);
+    if (!cx) {
+        return error;
+    }
+
+    pc += __GLX_SINGLE_HDR_SIZE;
+    pname = *(GLenum *) (pc + 0);
+    compsize = isFloat ? __glGetFloatv_size(pname)
+        : __glGetIntegerv_size(pname);
+    params = __glXGetAnswerBuffer(cl, compsize * 4, answerBuffer,
+                                  sizeof(answerBuffer), 4);
+    if (params == NULL)
+        return BadAlloc;
+    __glXClearErrorOccured();
+
+    if (!__glXGetCachedv(cx, pname, isFloat, params)) {
+        if (isFloat)
+            glGetFloatv(pname, params);
+        else
+            glGetIntegerv(pname, params);
+        __glXPutCachedv(cx, pname, isFloat, params);
+    }
+
+    if (need_swap) {
+        __GLX_SWAP_INT_ARRAY(params, compsize);
+        __glXSendReplySwap(client, params, compsize, 4, GL_FALSE, 0);
+    }
+    else {
+        __glXSendReply(client, params, compsize, 4, GL_FALSE, 0);
+    }
+    return Success;
+}
+
+int
+__glXDisp_GetFloatv(__GLXclientState * cl, GLbyte * pc)
+{
+    return DoGetv(cl, pc, GL_TRUE, GL_FALSE);
+}
+
+int
+__glXDisp_GetIntegerv(__GLXclientState * cl, GLbyte * pc)
+{
+    return DoGetv(cl, pc, GL_FALSE, GL_FALSE);
+}
+
 int
 DoGetString(__GLXclientState * cl, GLbyte * pc, GLboolean need_swap)
 {
@@ -284,3 +284,15 @@ __glXDispSwap_GetString(__GLXclientState * cl, GLbyte * pc)
 {
     return DoGetString(cl, pc, GL_TRUE);
 }
+
+int
+__glXDispSwap_GetFloatv(__GLXclientState * cl, GLbyte * pc)
+{
+    return DoGetv(cl, pc, GL_TRUE, GL_TRUE);
+}
+
+int
+__glXDispSwap_GetIntegerv(__GLXclientState * cl, GLbyte * pc)
+{
+    return DoGetv(cl, pc, GL_FALSE, GL_TRUE);
+}
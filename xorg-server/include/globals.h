@@ -21,6 +21,7 @@ extern _X_EXPORT Bool screenSaverSuspended;
 #endif
 
 extern _X_EXPORT const char *defaultFontPath;
+extern _X_EXPORT Bool prerasterizeFonts;
 extern _X_EXPORT int monitorResolution;
 extern _X_EXPORT int defaultColorVisualClass;
 
@@ -577,6 +577,7 @@ UseMsg(void)
     ErrorF("-reset                 reset after last client exists\n");
     ErrorF("-pn                    accept failure to listen on all ports\n");
     ErrorF("-nopn                  reject failure to listen on all ports\n");
+    ErrorF("-prerasterize          rasterise glyphs of opened fonts in the background\n");
     ErrorF("-r                     turns off auto-repeat\n");
     ErrorF("r                      turns on auto-repeat \n");
     ErrorF("-render [default|mono|gray|color] set render color alloc policy\n");
@@ -918,6 +919,8 @@ ProcessCommandLine(int argc, char *argv[])
             PartialNetwork = TRUE;
         else if (strcmp(argv[i], "-nopn") == 0)
             PartialNetwork = FALSE;
+        else if (strcmp(argv[i], "-prerasterize") == 0)
+            prerasterizeFonts = TRUE;
         else if (strcmp(argv[i], "r") == 0)
             defaultKeyboardControl.autoRepeat = TRUE;
         else if (strcmp(argv[i], "-r") == 0)